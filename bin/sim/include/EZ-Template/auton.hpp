@@ -0,0 +1,14 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace ez {
+class Auton {
+ public:
+  Auton();
+  Auton(std::string, std::function<void()>);
+  std::string Name;
+  std::function<void()> auton_call;
+};
+}  // namespace ez
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+#include "EZ-Template/auton.hpp"
+
+using namespace std;
+
+namespace ez {
+class AutonSelector {
+ public:
+  std::vector<Auton> Autons;
+  int auton_page_current;
+  int auton_count;
+  AutonSelector();
+  AutonSelector(std::vector<Auton> autons);
+  void selected_auton_call();
+  void selected_auton_print();
+  void autons_add(std::vector<Auton> autons);
+};
+}  // namespace ez
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "EZ-Template/auton_selector.hpp"
+#include "api.h"
+
+namespace ez {
+namespace as {
+extern AutonSelector auton_selector;
+void initialize();
+void shutdown();
+bool enabled();
+void page_up();
+void page_down();
+}  // namespace as
+}  // namespace ez
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+#include "api.h"
+
+extern pros::Controller master;
+
+namespace ez {
+void ez_template_print();
+void screen_print(std::string text, int line = 0);
+
+enum e_type { SINGLE = 0,
+              SPLIT = 1 };
+
+enum e_swing { LEFT_SWING = 0,
+               RIGHT_SWING = 1 };
+
+enum exit_output { RUNNING = 1,
+                   SMALL_EXIT = 2,
+                   BIG_EXIT = 3,
+                   VELOCITY_EXIT = 4,
+                   mA_EXIT = 5,
+                   ERROR_NO_CONSTANTS = 6 };
+
+enum e_mode { DISABLE = 0,
+              SWING = 1,
+              TURN = 2,
+              DRIVE = 3 };
+
+std::string exit_to_string(exit_output input);
+
+namespace util {
+extern bool AUTON_RAN;
+int sgn(double input);
+bool reversed_active(double input);
+double clamp(double input, double max, double min);
+const bool SD_CARD_ACTIVE = pros::usd::is_installed();
+const int DELAY_TIME = 10;
+}  // namespace util
+}  // namespace ez
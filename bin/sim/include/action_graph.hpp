@@ -0,0 +1,114 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "motion.hpp"
+
+/**
+ * Runs an autonomous as a graph of steps instead of a list of pid_wait()s and
+ * delays.  A step starts once every step it's after is done and its trigger
+ * is true, so mechanisms can run while the chassis is moving and nothing
+ * waits on a guessed delay.
+ *
+ * \code
+ * ActionGraph graph;
+ * int drive = graph.motion("drive to mogo", [](){ chassis.pid_drive_set(-24_in, 110); });
+ * graph.add("clamp", clampMogo, {}, graph.during(drive, driveErrorBelow(2)));
+ * graph.run();
+ * \endcode
+ */
+class ActionGraph {
+ public:
+  /**
+   * Adds a step.
+   *
+   * \param name
+   *        Name of the step, prints if the graph times out
+   * \param action
+   *        Runs once when the step starts
+   * \param after
+   *        Steps that have to be done before this one starts
+   * \param trigger
+   *        Optional, the step won't start until this returns true
+   * \param done
+   *        Optional, the step is done once this returns true.  Without it the
+   *        step is done as soon as the action runs
+   *
+   * \return The step's id, for use in other steps' after lists
+   */
+  int add(std::string name, std::function<void()> action, std::vector<int> after = {}, std::function<bool()> trigger = nullptr, std::function<bool()> done = nullptr);
+
+  /**
+   * Adds a chassis motion.  It's done when the motion exits, the same as
+   * pid_wait().  Starting a motion ends whatever motion was running.
+   *
+   * \param name
+   *        Name of the step, prints if the graph times out
+   * \param action
+   *        Starts the motion, ie. chassis.pid_drive_set(24_in, 110)
+   * \param after
+   *        Steps that have to be done before this one starts
+   * \param trigger
+   *        Optional, the motion won't start until this returns true
+   *
+   * \return The step's id, for use in other steps' after lists
+   */
+  int motion(std::string name, std::function<void()> action, std::vector<int> after = {}, std::function<bool()> trigger = nullptr);
+
+  /**
+   * Adds a step that does nothing for a while, ie. letting the intake pull a
+   * ring in.
+   *
+   * \param name
+   *        Name of the step, prints if the graph times out
+   * \param time
+   *        How long the step takes in ms
+   * \param after
+   *        Steps that have to be done before this one starts
+   *
+   * \return The step's id, for use in other steps' after lists
+   */
+  int wait(std::string name, int time, std::vector<int> after = {});
+
+  /**
+   * Trigger for starting something part way through another step.  True once
+   * that step has started and the trigger is true.  Use this instead of
+   * putting the step in the after list when they should overlap.
+   *
+   * \param id
+   *        Step that has to be running first
+   * \param trigger
+   *        Checked once the step has started, ie. driveErrorBelow(3)
+   */
+  std::function<bool()> during(int id, std::function<bool()> trigger);
+
+  /**
+   * Runs every step until they're all done.
+   *
+   * \param timeout
+   *        Gives up after this long in ms
+   *
+   * \return True if every step finished
+   */
+  bool run(int timeout = 15000);
+
+ private:
+  struct Node {
+    std::string name;
+    std::function<void()> action;
+    std::vector<int> after;
+    std::function<bool()> trigger;
+    std::function<bool()> done;
+    bool is_motion = false;
+    int time = 0;
+    bool started = false;
+    bool finished = false;
+    int start_time = 0;
+  };
+  std::vector<Node> nodes;
+  int active_motion = -1;
+  MotionWait motion_wait;
+  bool ready(Node& node);
+};
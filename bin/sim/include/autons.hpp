@@ -0,0 +1,31 @@
+#pragma once
+
+#include "EZ-Template/auton.hpp"
+#include "EZ-Template/drive/drive.hpp"
+
+extern Drive chassis;
+
+void drive_example();
+void turn_example();
+void drive_and_turn();
+void wait_until_change_speed();
+void swing_example();
+void motion_chaining();
+void combining_movements();
+void interfered_example();
+
+void bluePositive();
+void blueNegative();
+void redNegative();
+void redPositive();
+
+void redElimNegative();
+void redElimPositive();
+void blueElimNegative();
+void blueElimPositive();
+
+void skills();
+std::vector<ez::Auton> skillsCheckpoints();
+
+void default_constants();
+void autonSplines();
\ No newline at end of file
@@ -0,0 +1 @@
+void autonTestor(InputReader& input);
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+/**
+ * Finds turn and swing constants on the robot instead of by hand with the PID
+ * tuner.
+ *
+ * A relay experiment (Åström and Hägglund) bangs the drive between +power and
+ * -power every time the IMU crosses the target, so the robot rocks back and
+ * forth around it.  How far it rocks and how fast gives the ultimate gain and
+ * period, and a few Ziegler-Nichols style rules turn those into candidate
+ * constants.  Each candidate and the current constants then run the same test
+ * turns, and the fastest one that doesn't overshoot too much is kept and saved
+ * to /usd/autotune.txt.
+ */
+
+enum autotune_motion { AUTOTUNE_TURN = 0,
+                       AUTOTUNE_SWING = 1 };
+
+/**
+ * Runs the relay experiment and test turns, then sets the best constants on
+ * the chassis and saves them to the SD card.  Blocks for about 30 seconds
+ * with the robot spinning in place, so give it room.
+ *
+ * \param motion
+ *        AUTOTUNE_TURN or AUTOTUNE_SWING, swings are tuned as left swings
+ */
+void autotuneRun(autotune_motion motion);
+
+/**
+ * Sets constants saved by autotuneRun() on the chassis, if there are any.
+ * Call after default_constants().
+ */
+void autotuneLoad();
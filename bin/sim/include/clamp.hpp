@@ -0,0 +1,6 @@
+bool clampPressed();
+void clampToggle();
+
+void clampMogo();
+
+void unclampMogo();
@@ -0,0 +1,3 @@
+bool doinkerPressed();
+void doinkerToggle();
+void doinkerSet(bool value);
@@ -0,0 +1,13 @@
+// the driver's unjam and pulse macros, intakeControl() ticks them
+extern Macro intakeReverse;
+extern Macro intakePulse;
+
+void intakeControl();
+
+void intakeOn();
+
+void intakeOff();
+
+void intakeStop();
+
+void bottomIntakeOnly();
\ No newline at end of file
@@ -0,0 +1,16 @@
+void liftControl();
+
+void liftDown();
+void liftLoad();
+
+// starts scoring in the background, the chassis can keep driving
+void liftScore();
+void liftScoreIterate();
+bool liftScoreDone();
+bool liftScoreUsingIntake();
+void liftScoreCancel();
+// something else is running the intake, the score leaves it alone from here
+void liftScoreIntakeRelease();
+
+void intakeUp();
+void intakeDown();
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "EZ-Template/util.hpp"
+
+/**
+ * Holds a loop at a fixed rate with pros::Task::delay_until() and keeps track
+ * of how well it's keeping up.  pros::delay() sleeps for the period on top of
+ * however long the loop took, this sleeps until the next period starts.
+ */
+class LoopTimer {
+ public:
+  /**
+   * Loop stats since the last stats_reset().  All times are in microseconds.
+   */
+  struct Stats {
+    int cycles = 0;
+    int overruns = 0;          // cycles where the loop body took longer than the period
+    int latency_max = 0;       // longest loop body
+    double latency_avg = 0.0;  // average loop body
+    int jitter_max = 0;        // furthest a period landed from the target
+    double jitter_avg = 0.0;   // average distance from the target period
+  };
+
+  /**
+   * LoopTimer constructor.
+   *
+   * \param name
+   *        Name used when printing stats
+   * \param period
+   *        Time between loops in ms, defaults to ez::util::DELAY_TIME (100hz)
+   */
+  LoopTimer(std::string name, int period = ez::util::DELAY_TIME);
+
+  /**
+   * Sleeps until the next period.  Call this at the end of every loop.
+   */
+  void wait();
+
+  /**
+   * Starts timing from now.  Call right before the loop starts.
+   */
+  void reset();
+
+  /**
+   * Sets the period in ms.
+   */
+  void period_set(int period);
+
+  /**
+   * Returns the period in ms.
+   */
+  int period_get();
+
+  /**
+   * Returns the stats since the last reset.
+   */
+  Stats stats_get();
+
+  /**
+   * Clears the stats.
+   */
+  void stats_reset();
+
+  /**
+   * Returns a short line with the stats, fits on one line of the brain screen.
+   */
+  std::string stats_string();
+
+  /**
+   * Prints the stats to the terminal.
+   */
+  void stats_print();
+
+ private:
+  std::string name;
+  int period;
+  std::uint32_t next_wake = 0;
+  std::uint64_t cycle_start = 0;
+  std::uint64_t last_wake = 0;
+  double latency_total = 0.0;
+  double jitter_total = 0.0;
+  Stats stats;
+};
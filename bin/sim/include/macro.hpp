@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+/**
+ * A macro is a list of timed steps that advances a little bit every control
+ * cycle instead of blocking with pros::delay().  Call iterate() once per loop
+ * and the macro moves on to the next step once the current one has run for
+ * its time.
+ */
+class Macro {
+ public:
+  /**
+   * One step of a macro.
+   *
+   * \param action
+   *        Runs once when the step starts, ie. intake.move(127)
+   * \param time
+   *        How long to stay on this step in ms before moving on
+   */
+  struct Step {
+    std::function<void()> action;
+    int time;
+  };
+
+  /**
+   * Macro constructor.
+   *
+   * \param steps
+   *        Steps to run in order
+   */
+  Macro(std::vector<Step> steps);
+
+  /**
+   * Starts the macro from the first step.  If it's already running it restarts.
+   *
+   * \param now
+   *        Current time in ms, normally pros::millis()
+   */
+  void start(int now);
+
+  /**
+   * Stops the macro where it is.  The last action is left as is.
+   */
+  void cancel();
+
+  /**
+   * Returns true if the macro isn't running.
+   */
+  bool is_done();
+
+  /**
+   * Runs the macro for this cycle.  Call this every loop.
+   *
+   * \param now
+   *        Current time in ms, normally pros::millis()
+   */
+  void iterate(int now);
+
+ private:
+  std::vector<Step> steps;
+  int current = 0;
+  int step_start = 0;
+  bool running = false;
+  void step_enter(int now);
+};
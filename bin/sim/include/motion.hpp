@@ -0,0 +1,221 @@
+#pragma once
+
+#include <functional>
+
+#include "EZ-Template/drive/drive.hpp"
+#include "okapi/api/units/QAngle.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "baked_profile.hpp"
+#include "path.hpp"
+
+/**
+ * Helpers for running chassis motions without blocking in pid_wait().
+ */
+
+/**
+ * Does one loop of chassis.pid_wait() at a time, so something else can check
+ * it every cycle instead of sitting in the while loop.
+ */
+class MotionWait {
+ public:
+  /**
+   * Starts watching a new motion.  Call right after pid_*_set().
+   */
+  void reset();
+
+  /**
+   * Checks the exit conditions of the current motion once.  Returns
+   * ez::RUNNING until the motion exits, then how it exited.
+   */
+  ez::exit_output iterate();
+
+  /**
+   * Returns how long in ms the motion spent between first getting inside its
+   * big exit error and exiting.
+   */
+  int settle_time_get();
+
+ private:
+  ez::exit_output left_exit = ez::RUNNING;
+  ez::exit_output right_exit = ez::RUNNING;
+  ez::exit_output exit = ez::RUNNING;
+  int settle_start = -1;
+  int settle_time = 0;
+};
+
+/**
+ * True once the drive PID is within this many inches of its target.
+ */
+std::function<bool()> driveErrorBelow(double inches);
+
+/**
+ * True once the turn or swing PID is within this many degrees of its target.
+ */
+std::function<bool()> turnErrorBelow(double degrees);
+
+/**
+ * True once the robot has turned past this heading on the way to the current
+ * turn or swing target.
+ */
+std::function<bool()> headingPast(double degrees);
+
+/**
+ * Sets if motions should be mirrored across the field.  Autons are written
+ * for blue, and mirroring flips every heading and swaps swing sides so the
+ * same routine runs from the red side.
+ *
+ * \param mirrored
+ *        True to mirror
+ */
+void mirrorSet(bool mirrored);
+
+/**
+ * Returns true if motions are being mirrored.
+ */
+bool mirrorGet();
+
+/**
+ * Returns a heading flipped if motions are being mirrored.
+ *
+ * \param degrees
+ *        Heading as written for blue
+ */
+double mirrorAngle(double degrees);
+
+/**
+ * Runs an auton with mirroring on, then turns it back off.  The auton task is
+ * killed at the end of the period without getting that far, so autonomous()
+ * and disabled() turn mirroring off too.
+ *
+ * \param auton
+ *        Auton written for blue
+ */
+void runMirrored(std::function<void()> auton);
+
+/**
+ * Returns a number that goes up every time one of the motion wrappers below
+ * starts a motion, so something waiting on a motion can tell it was replaced.
+ */
+unsigned motionId();
+
+/**
+ * chassis.pid_drive_set() that shows up in the auton timing report.
+ */
+void driveSet(okapi::QLength target, int speed, bool slew_on = false, bool toggle_heading = true);
+
+/**
+ * chassis.pid_wait() that records how the motion exited and how long it spent
+ * settling in the auton timing report.
+ */
+void pidWait();
+
+/**
+ * chassis.pid_turn_set() that follows mirrorSet().
+ */
+void turnSet(okapi::QAngle target, int speed, bool slew_on = false);
+
+/**
+ * chassis.pid_turn_relative_set() that follows mirrorSet().
+ */
+void turnRelativeSet(okapi::QAngle target, int speed, bool slew_on = false);
+
+/**
+ * chassis.pid_swing_set() that follows mirrorSet().  The swing side is
+ * swapped along with the heading.
+ */
+void swingSet(ez::e_swing type, okapi::QAngle target, int speed, int opposite_speed = 0, bool slew_on = false);
+
+/**
+ * chassis.pid_swing_relative_set() that follows mirrorSet().
+ */
+void swingRelativeSet(ez::e_swing type, okapi::QAngle target, int speed, int opposite_speed = 0, bool slew_on = false);
+
+/**
+ * Drives to a point, facing whichever way it needs to get there, see
+ * odom_motion.hpp.  Follows mirrorSet(), x flips along with headings.
+ *
+ * \param x
+ *        Field x, 0 is where the auton started
+ * \param y
+ *        Field y, forward from where the auton started
+ * \param speed
+ *        Most power, out of 127
+ * \param backwards
+ *        Drive there with the back of the robot
+ */
+void odomPointSet(okapi::QLength x, okapi::QLength y, int speed, bool backwards = false);
+
+/**
+ * Drives to a point and ends facing a heading, in one curve, see
+ * odom_motion.hpp.  Follows mirrorSet().
+ *
+ * \param x
+ *        Field x, 0 is where the auton started
+ * \param y
+ *        Field y, forward from where the auton started
+ * \param theta
+ *        Heading to end at, like the IMU
+ * \param speed
+ *        Most power, out of 127
+ * \param backwards
+ *        Drive there with the back of the robot, ie. to clamp a mogo
+ */
+void odomPoseSet(okapi::QLength x, okapi::QLength y, okapi::QAngle theta, int speed, bool backwards = false);
+
+/**
+ * Follows a path with pure pursuit, see odom_motion.hpp.  Follows
+ * mirrorSet().
+ *
+ * \param path
+ *        Path to follow, in inches from where the auton started
+ * \param speed
+ *        Most power, out of 127
+ * \param backwards
+ *        Follow it with the back of the robot
+ */
+void odomPathSet(const Path& path, int speed, bool backwards = false);
+
+/**
+ * Drives straight along a baked profile, see baked_profile.hpp.  Straight
+ * lines don't change when mirrored.
+ *
+ * \param profile
+ *        Profile from bakedProfile(), ie. bakedProfile("blue elim positive start")
+ * \param backwards
+ *        Drive it with the back of the robot
+ */
+void profileDriveSet(const BakedProfile& profile, bool backwards = false);
+
+/**
+ * chassis.drive_angle_set() that follows mirrorSet().
+ */
+void driveAngleSet(okapi::QAngle angle);
+
+/**
+ * Runs a callback once the robot has driven this far into the current drive
+ * motion.  Call right after pid_drive_set().  Markers left over from an
+ * older motion are dropped when a new one starts.
+ *
+ * \param distance
+ *        Distance from where the motion started, negative for backwards
+ * \param callback
+ *        Runs once, ie. clampMogo
+ */
+void markerDistance(okapi::QLength distance, std::function<void()> callback);
+
+/**
+ * Runs a callback once the robot turns past a heading in the current turn or
+ * swing.  Call right after turnSet() or swingSet().  The heading is mirrored
+ * along with the motion.
+ *
+ * \param angle
+ *        Heading to fire at
+ * \param callback
+ *        Runs once, ie. intakeOn
+ */
+void markerAngle(okapi::QAngle angle, std::function<void()> callback);
+
+/**
+ * Checks markers against the sensors.  Runs from the executor.
+ */
+void markersIterate();
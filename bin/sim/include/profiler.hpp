@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "pros/rtos.hpp"
+
+/**
+ * Set PROFILER_ENABLED to 0 (ie. EXTRA_CXXFLAGS=-DPROFILER_ENABLED=0 in the
+ * Makefile) to compile the executor's job timing out.
+ */
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+/**
+ * Fixed bucket histogram of times in microseconds.  There are 256 buckets,
+ * 20us wide by default (up to 5.1ms), anything longer lands in the last
+ * bucket.  Recording is lock free so any task can record into it.
+ */
+class Histogram {
+ public:
+  static const int BUCKETS = 256;
+
+  /**
+   * Histogram constructor.
+   *
+   * \param name
+   *        Name used when printing
+   * \param bucket_width
+   *        Width of each bucket in microseconds
+   */
+  Histogram(std::string name, int bucket_width = 20);
+
+  /**
+   * Adds a time to the histogram.
+   *
+   * \param time
+   *        Time in microseconds
+   */
+  void record(int time);
+
+  /**
+   * Returns the time in microseconds that p of the samples are under.
+   *
+   * \param p
+   *        0.0 to 1.0, ie. 0.99 for p99
+   */
+  int percentile(double p);
+
+  /**
+   * Returns the longest time recorded in microseconds.
+   */
+  int max_get();
+
+  /**
+   * Returns how many times were recorded.
+   */
+  int count_get();
+
+  /**
+   * Clears the histogram.
+   */
+  void reset();
+
+  /**
+   * Returns the name.
+   */
+  std::string name_get();
+
+ private:
+  std::string name;
+  int bucket_width;
+  std::atomic<std::uint32_t> buckets[BUCKETS];
+  std::atomic<std::uint32_t> count{0};
+  std::atomic<int> max{0};
+};
+
+/**
+ * Times from construction to destruction and records it into a histogram.
+ */
+class ScopedTimer {
+ public:
+  ScopedTimer(Histogram& histogram) : histogram(histogram), start(pros::micros()) {}
+  ~ScopedTimer() { histogram.record(pros::micros() - start); }
+
+ private:
+  Histogram& histogram;
+  std::uint64_t start;
+};
+
+/**
+ * Returns the histogram with this name, making it if it doesn't exist yet.
+ *
+ * \param name
+ *        Name of the histogram
+ * \param bucket_width
+ *        Width of each bucket in microseconds, only used when making it
+ */
+Histogram& profilerGet(std::string name, int bucket_width = 20);
+
+/**
+ * Prints count, p50, p99 and max of every histogram to the terminal.
+ */
+void profilerPrint();
+
+/**
+ * Writes the same report as profilerPrint() to /usd/profile.txt.
+ */
+void profilerSave();
+
+/**
+ * Clears every histogram.
+ */
+void profilerReset();
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string_view>
+
+#include "baked_profile.hpp"
+
+/**
+ * Every baked profile autons use, see baked_profile.hpp.  Speeds are in
+ * inches per second, the drive tops out around 80.
+ */
+
+// Backs away from the start toward the mogo in blueElimPositive()
+inline constexpr auto BLUE_ELIM_POSITIVE_START = profileBake<ProfileSpec{14.5, 70, 250, 4000}>();
+
+inline constexpr BakedProfile BAKED_PROFILES[] = {
+    profileNamed("blue elim positive start", BLUE_ELIM_POSITIVE_START),
+};
+
+/**
+ * Finds a baked profile by name.  Runs while compiling, so a name that isn't
+ * in BAKED_PROFILES doesn't build.
+ *
+ * \param name
+ *        Name in BAKED_PROFILES
+ */
+consteval BakedProfile bakedProfile(std::string_view name) {
+  for (const BakedProfile& profile : BAKED_PROFILES) {
+    if (name == profile.name) return profile;
+  }
+  throw "no baked profile with that name";
+}
@@ -0,0 +1,38 @@
+/**
+ * \file pros/adi.hpp
+ *
+ * Host stand-in for the ADI digital ports, backed by sim::adiState().
+ */
+
+#ifndef _PROS_ADI_HPP_
+#define _PROS_ADI_HPP_
+
+#include <cstdint>
+
+namespace pros {
+inline namespace v5 {
+namespace adi {
+class DigitalOut {
+ public:
+  DigitalOut(std::uint8_t adi_port, bool init_state = false);
+  std::int32_t set_value(bool value);
+
+ private:
+  std::uint8_t port;
+};
+
+class DigitalIn {
+ public:
+  DigitalIn(std::uint8_t adi_port);
+  std::int32_t get_value() const;
+  std::int32_t get_new_press();
+
+ private:
+  std::uint8_t port;
+  bool last = false;
+};
+}  // namespace adi
+}  // namespace v5
+}  // namespace pros
+
+#endif  // _PROS_ADI_HPP_
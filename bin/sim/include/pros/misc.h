@@ -0,0 +1,62 @@
+/**
+ * \file pros/misc.h
+ *
+ * Host stand-in for the PROS controller and competition constants.
+ */
+
+#ifndef _PROS_MISC_H_
+#define _PROS_MISC_H_
+
+#include <cstdint>
+
+namespace pros {
+typedef enum {
+  E_CONTROLLER_MASTER = 0,
+  E_CONTROLLER_PARTNER
+} controller_id_e_t;
+
+typedef enum {
+  E_CONTROLLER_ANALOG_LEFT_X = 0,
+  E_CONTROLLER_ANALOG_LEFT_Y,
+  E_CONTROLLER_ANALOG_RIGHT_X,
+  E_CONTROLLER_ANALOG_RIGHT_Y
+} controller_analog_e_t;
+
+typedef enum {
+  E_CONTROLLER_DIGITAL_L1 = 6,
+  E_CONTROLLER_DIGITAL_L2,
+  E_CONTROLLER_DIGITAL_R1,
+  E_CONTROLLER_DIGITAL_R2,
+  E_CONTROLLER_DIGITAL_UP,
+  E_CONTROLLER_DIGITAL_DOWN,
+  E_CONTROLLER_DIGITAL_LEFT,
+  E_CONTROLLER_DIGITAL_RIGHT,
+  E_CONTROLLER_DIGITAL_X,
+  E_CONTROLLER_DIGITAL_B,
+  E_CONTROLLER_DIGITAL_Y,
+  E_CONTROLLER_DIGITAL_A
+} controller_digital_e_t;
+}  // namespace pros
+
+#ifdef PROS_USE_SIMPLE_NAMES
+#define CONTROLLER_MASTER pros::E_CONTROLLER_MASTER
+#define CONTROLLER_PARTNER pros::E_CONTROLLER_PARTNER
+#define ANALOG_LEFT_X pros::E_CONTROLLER_ANALOG_LEFT_X
+#define ANALOG_LEFT_Y pros::E_CONTROLLER_ANALOG_LEFT_Y
+#define ANALOG_RIGHT_X pros::E_CONTROLLER_ANALOG_RIGHT_X
+#define ANALOG_RIGHT_Y pros::E_CONTROLLER_ANALOG_RIGHT_Y
+#define DIGITAL_L1 pros::E_CONTROLLER_DIGITAL_L1
+#define DIGITAL_L2 pros::E_CONTROLLER_DIGITAL_L2
+#define DIGITAL_R1 pros::E_CONTROLLER_DIGITAL_R1
+#define DIGITAL_R2 pros::E_CONTROLLER_DIGITAL_R2
+#define DIGITAL_UP pros::E_CONTROLLER_DIGITAL_UP
+#define DIGITAL_DOWN pros::E_CONTROLLER_DIGITAL_DOWN
+#define DIGITAL_LEFT pros::E_CONTROLLER_DIGITAL_LEFT
+#define DIGITAL_RIGHT pros::E_CONTROLLER_DIGITAL_RIGHT
+#define DIGITAL_X pros::E_CONTROLLER_DIGITAL_X
+#define DIGITAL_B pros::E_CONTROLLER_DIGITAL_B
+#define DIGITAL_Y pros::E_CONTROLLER_DIGITAL_Y
+#define DIGITAL_A pros::E_CONTROLLER_DIGITAL_A
+#endif
+
+#endif  // _PROS_MISC_H_
@@ -0,0 +1,48 @@
+/**
+ * \file pros/motor_group.hpp
+ *
+ * Host stand-in for pros::MotorGroup.  Commands go to every motor, reads come
+ * from the first one like they do in PROS.
+ */
+
+#ifndef _PROS_MOTOR_GROUP_HPP_
+#define _PROS_MOTOR_GROUP_HPP_
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "pros/motors.hpp"
+
+namespace pros {
+inline namespace v5 {
+class MotorGroup {
+ public:
+  MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset = MotorGears::invalid, const MotorUnits encoder_units = MotorUnits::invalid);
+  MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset = MotorGears::invalid, const MotorUnits encoder_units = MotorUnits::invalid);
+
+  std::int32_t move(std::int32_t voltage) const;
+  std::int32_t move_absolute(const double position, const std::int32_t velocity) const;
+  std::int32_t move_relative(const double position, const std::int32_t velocity) const;
+  std::int32_t move_velocity(const std::int32_t velocity) const;
+  std::int32_t move_voltage(const std::int32_t voltage) const;
+  std::int32_t brake() const;
+
+  double get_position(const std::uint8_t index = 0) const;
+  double get_actual_velocity(const std::uint8_t index = 0) const;
+  std::int32_t get_voltage(const std::uint8_t index = 0) const;
+  std::int32_t get_current_draw(const std::uint8_t index = 0) const;
+  std::int32_t is_over_current(const std::uint8_t index = 0) const;
+
+  std::int32_t tare_position(const std::uint8_t index = 0) const;
+  std::int32_t set_brake_mode(const motor_brake_mode_e_t mode, const std::uint8_t index = 0) const;
+  std::int32_t set_brake_mode_all(const motor_brake_mode_e_t mode) const;
+  std::int32_t size() const;
+
+ private:
+  std::vector<Motor> motors;
+};
+}  // namespace v5
+}  // namespace pros
+
+#endif  // _PROS_MOTOR_GROUP_HPP_
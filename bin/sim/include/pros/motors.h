@@ -0,0 +1,45 @@
+/**
+ * \file pros/motors.h
+ *
+ * Host stand-in for the PROS motor constants.
+ */
+
+#ifndef _PROS_MOTORS_H_
+#define _PROS_MOTORS_H_
+
+#include <cstdint>
+
+namespace pros {
+typedef enum motor_brake_mode_e {
+  E_MOTOR_BRAKE_COAST = 0,
+  E_MOTOR_BRAKE_BRAKE = 1,
+  E_MOTOR_BRAKE_HOLD = 2,
+  E_MOTOR_BRAKE_INVALID = INT32_MAX
+} motor_brake_mode_e_t;
+
+typedef enum motor_encoder_units_e {
+  E_MOTOR_ENCODER_DEGREES = 0,
+  E_MOTOR_ENCODER_ROTATIONS = 1,
+  E_MOTOR_ENCODER_COUNTS = 2,
+  E_MOTOR_ENCODER_INVALID = INT32_MAX
+} motor_encoder_units_e_t;
+
+typedef enum motor_gearset_e {
+  E_MOTOR_GEARSET_36 = 0,
+  E_MOTOR_GEARSET_18 = 1,
+  E_MOTOR_GEARSET_06 = 2,
+  E_MOTOR_GEARSET_INVALID = INT32_MAX
+} motor_gearset_e_t;
+}  // namespace pros
+
+#ifdef PROS_USE_SIMPLE_NAMES
+#define MOTOR_BRAKE_COAST pros::E_MOTOR_BRAKE_COAST
+#define MOTOR_BRAKE_BRAKE pros::E_MOTOR_BRAKE_BRAKE
+#define MOTOR_BRAKE_HOLD pros::E_MOTOR_BRAKE_HOLD
+#define MOTOR_BRAKE_INVALID pros::E_MOTOR_BRAKE_INVALID
+#define MOTOR_GEARSET_36 pros::E_MOTOR_GEARSET_36
+#define MOTOR_GEARSET_18 pros::E_MOTOR_GEARSET_18
+#define MOTOR_GEARSET_06 pros::E_MOTOR_GEARSET_06
+#endif
+
+#endif  // _PROS_MOTORS_H_
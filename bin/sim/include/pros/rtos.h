@@ -0,0 +1,19 @@
+/**
+ * \file pros/rtos.h
+ *
+ * Host stand-in for the PROS RTOS constants.
+ */
+
+#ifndef _PROS_RTOS_H_
+#define _PROS_RTOS_H_
+
+#include <cstdint>
+
+#define TASK_PRIORITY_MAX 16
+#define TASK_PRIORITY_MIN 1
+#define TASK_PRIORITY_DEFAULT 8
+#define TASK_STACK_DEPTH_DEFAULT 0x2000
+#define TASK_STACK_DEPTH_MIN 0x200
+#define TIMEOUT_MAX ((uint32_t)0xffffffffUL)
+
+#endif  // _PROS_RTOS_H_
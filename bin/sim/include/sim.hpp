@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Host side simulation of the robot, used by `make sim`.
+ *
+ * Every pros::Task is a real thread, but only one of them runs at a time and
+ * the clock only moves forward when they're all waiting on a delay.  The world
+ * steps 1ms at a time in between, so a run comes out the same every time no
+ * matter how fast or busy the PC is.
+ */
+namespace sim {
+
+/**
+ * Where the robot is.  x and y are in inches, theta is in degrees with the
+ * same sign as the IMU, clockwise positive and 0 facing +y.
+ */
+struct Pose {
+  double x = 0;
+  double y = 0;
+  double theta = 0;
+};
+
+/**
+ * Things about the robot and field the code can't see.  The defaults are a
+ * 15lb robot on 3.25" wheels, change them before running anything.
+ */
+struct Config {
+  double track_width = 12.5;          // Inches between the left and right wheels
+  double mass = 6.8;                  // kg
+  double moment_of_inertia = 0.15;    // kg m^2 around the center of the robot
+  double wheel_inertia = 0.0015;      // kg m^2 of one side's wheels, gears and motor rotors
+  double wheel_friction = 0.9;        // Most the wheels can push on the tiles before slipping, times weight
+  double rolling_resistance = 0.02;   // Drag from the wheels rolling, times weight
+  double scrub = 0.3;                 // Sideways friction that fights turning, times weight
+  double scrub_arm = 4;               // Inches from the center to the wheels that get dragged sideways
+  double battery = 12.6;              // Volts before sag
+  double imu_scale = 1.0115;          // True rotation over what the IMU reports, the robot's scaler undoes this
+  double imu_noise = 0.02;            // Degrees of noise on each IMU sample
+  double imu_drift = 0;               // Degrees per second the IMU drifts
+  double imu_bias_walk = 0.005;       // How fast the IMU's drift wanders, degrees per root second
+  double motor_time_constant = 0.06;  // Seconds for a mechanism motor to reach 63% of its new speed
+  Pose start;                         // Where the robot really starts, the code always thinks it's at 0
+  std::uint32_t seed = 0;             // Seed for the noise
+  bool quiet = false;                 // Stops EZ from printing exits
+};
+
+enum motor_mode { MOTOR_VOLTAGE = 0,
+                  MOTOR_VELOCITY = 1,
+                  MOTOR_POSITION = 2 };
+
+/**
+ * One smart port's motor.  Everything is in the motor's own direction, the
+ * reversing from a negative port happens in pros::Motor.
+ */
+struct MotorState {
+  bool used = false;
+  int free_rpm = 200;
+  int brake = 0;
+  motor_mode mode = MOTOR_VOLTAGE;
+  double command = 0;  // mV, rpm or degrees depending on mode
+  double max_velocity = 0;
+  double position = 0;  // Degrees, before tare
+  double zero = 0;
+  double velocity = 0;  // rpm
+  double voltage = 0;   // mV that actually went to the motor
+  double current = 0;   // mA
+  bool holding = false;  // Brake mode hold is holding hold_position
+  double hold_position = 0;
+};
+
+struct ControllerState {
+  int analog[4] = {0, 0, 0, 0};
+  bool digital[18] = {};
+};
+
+/**
+ * Returns the config, change it before running anything.
+ */
+Config& config();
+
+/**
+ * Sets a config value by name, ie. configSet("battery", 12.1).  start_x,
+ * start_y and start_theta set the start pose.  Returns false if there's no
+ * value with that name.
+ */
+bool configSet(std::string name, double value);
+
+/**
+ * Returns how long the simulation has been running in microseconds.
+ */
+std::uint64_t timeGet();
+
+/**
+ * Starts a task.  It doesn't run until the scheduler gets to it.
+ *
+ * \param function
+ *        What the task runs
+ * \param priority
+ *        Higher runs first when two tasks wake at the same time
+ * \param name
+ *        Name for printing
+ */
+int taskCreate(std::function<void()> function, std::uint32_t priority, const char* name);
+
+/**
+ * Returns the task that's running, 0 if it's the scheduler.
+ */
+int taskCurrent();
+
+/**
+ * Returns true once the task's function has returned or it was removed.
+ */
+bool taskDone(int task);
+
+/**
+ * Stops a task from ever running again.
+ */
+void taskRemove(int task);
+
+const char* taskName(int task);
+std::uint32_t taskPriority(int task);
+
+/**
+ * Gives up the rest of this turn until the clock reaches wake.
+ *
+ * \param wake
+ *        Time to wake up in microseconds
+ */
+void sleepUntil(std::uint64_t wake);
+
+/**
+ * Runs tasks and moves the clock until done() is true or the time is up.
+ * Only call this from main().
+ *
+ * \param done
+ *        Checked between every task turn
+ * \param timeout
+ *        Most time to run in ms
+ */
+bool runUntil(std::function<bool()> done, std::uint32_t timeout);
+
+/**
+ * Motor on a smart port, 1 to 21.
+ */
+MotorState& motorState(int port);
+
+/**
+ * ADI output on a port, 1 to 8.
+ */
+bool& adiState(int port);
+
+/**
+ * What the controller is reporting.
+ */
+ControllerState& controllerState();
+
+/**
+ * Tells the world which motors move the robot.
+ *
+ * \param left_ports
+ *        Left motors, negative is reversed
+ * \param right_ports
+ *        Right motors, negative is reversed
+ * \param wheel_diameter
+ *        Wheel diameter in inches
+ * \param wheel_rpm
+ *        Wheel rpm when the motors are at full speed
+ */
+void drivetrainSet(std::vector<int> left_ports, std::vector<int> right_ports, double wheel_diameter, double wheel_rpm);
+
+/**
+ * Returns where the robot is.
+ */
+Pose poseGet();
+
+/**
+ * Puts the robot somewhere.  The IMU keeps reading what it read before.
+ */
+void poseSet(Pose pose);
+
+/**
+ * Returns the IMU's rotation in degrees, with the IMU's scale error, noise
+ * and drift in it.  This updates every 10ms like the real one.
+ */
+double imuGet();
+
+/**
+ * How a set of test motions went, see tuneRun().
+ */
+struct TuneResult {
+  double settle = 0;     // Seconds spent in pid_wait() over every motion
+  double overshoot = 0;  // Most any motion went past its target, inches or degrees
+  double error = 0;      // Most any motion was off its target when pid_wait() returned
+  double heading = 0;    // Most the heading wandered during drive motions, degrees
+};
+
+/**
+ * Sets the chassis' constants by name.  drive, heading, turn and swing take
+ * p, i, d, start_i and drive_exit, turn_exit and swing_exit take the six
+ * numbers pid_*_exit_condition_set() does.  Returns false if the name or the
+ * number of values is wrong.
+ */
+bool tuneSet(std::string name, std::vector<double> values);
+
+/**
+ * Returns the chassis' constants the way tuneSet() takes them, one name=values
+ * per line.
+ */
+std::string tuneGet();
+
+/**
+ * Runs a fixed set of drive, turn or swing motions back to back with the
+ * chassis' current constants and measures them.  Call from a task after
+ * initialize().
+ *
+ * \param motion
+ *        "drive", "turn" or "swing"
+ */
+TuneResult tuneRun(std::string motion);
+
+/**
+ * Steps motors and the robot forward.  The drive motors use the V5 motor
+ * curve pushing the robot's mass through wheel friction, mechanisms are a
+ * simple lag.
+ *
+ * \param dt
+ *        Seconds to step
+ */
+void worldStep(double dt);
+
+}  // namespace sim
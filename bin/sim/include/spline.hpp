@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "odom.hpp"
+#include "path.hpp"
+
+/**
+ * Curved paths through poses, for autons to follow with odomPathSet().
+ *
+ * Each pair of poses is joined with a quintic spline that leaves and arrives
+ * along their headings, then filled in to a Path.  Autons add theirs by name
+ * in autonSplines(), and initialize() loads them all from
+ * /usd/splines.bin, so an auton only ever looks one up.  A spline that isn't
+ * in the file, or that changed since it was written, is made on the brain
+ * and the file is written again.
+ *
+ * `bin/sim/robot --splines splines.bin` writes the same file on a PC, copy
+ * it to the SD card so the brain never makes any.
+ *
+ * The file is "SPL1", the number of splines, then for each one a hash of its
+ * poses and spacing, the number of points, every x and every y as floats.
+ */
+
+// Where splinesLoad() reads and writes the splines
+extern const char* SPLINE_CACHE_PATH;
+
+/**
+ * Makes a path through poses, curving between them.
+ *
+ * \param poses
+ *        Poses to drive through, field inches and IMU degrees like odomGet()
+ * \param spacing
+ *        Inches between points on the path
+ */
+Path splinePath(const std::vector<Pose>& poses, double spacing = 1.0);
+
+/**
+ * Adds a spline for splinesLoad() to load or make.  Call before splinesLoad().
+ *
+ * \param name
+ *        Name to look it up by with splineGet()
+ * \param poses
+ *        Poses to drive through, from where the auton starts
+ * \param spacing
+ *        Inches between points on the path
+ */
+void splineAdd(const std::string& name, std::vector<Pose> poses, double spacing = 1.0);
+
+/**
+ * Loads every added spline from SPLINE_CACHE_PATH, makes the ones that are
+ * missing and writes the file again if it had to make any.
+ */
+void splinesLoad();
+
+/**
+ * Loads the added splines that are in a file in the same format as
+ * SPLINE_CACHE_PATH, leaving the rest alone.  Stops at the first entry that
+ * doesn't fit in the file.  Returns how many it loaded.
+ *
+ * \param file
+ *        File to read
+ */
+int splinesRead(const char* file);
+
+/**
+ * Writes every added spline to a file in the same format as
+ * SPLINE_CACHE_PATH.  Returns false if the file couldn't be written.
+ *
+ * \param file
+ *        File to write
+ */
+bool splinesWrite(const char* file);
+
+/**
+ * Returns a spline by name, or an empty path that odomPathSet() ignores if
+ * there isn't one.
+ *
+ * \param name
+ *        Name it was added with
+ */
+const Path& splineGet(const std::string& name);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "api.h"
+#include "cached_out.hpp"
+#include "pros/adi.hpp"
+
+// Your motors, sensors, etc. should go here.  Below are examples
+
+// inline pros::Motor intake(1);
+// inline pros::adi::DigitalIn limit_switch('A');
+
+// Drive measurements, for the chassis constructor and the odom motions
+const double DRIVE_WHEEL_DIAMETER = 3.25;  // Remember, 4" wheels without screw holes are actually 4.125!
+const double DRIVE_WHEEL_RPM = 480;
+const double DRIVE_TRACK_WIDTH = 12.5;     // Left to right wheel, measure yours
+
+
+
+inline pros::MotorGroup intake({1,2});
+inline pros::Motor lift(-9);
+
+// Pistons only write to the ADI when their value changes, see cached_out.hpp
+inline CachedDigitalOut clamp1(5);
+inline CachedDigitalOut clamp2(4);
+inline CachedDigitalOut doinker(2);
+inline CachedDigitalOut intakePiston(7);
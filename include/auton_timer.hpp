@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+
+#include "EZ-Template/util.hpp"
+
+/**
+ * Times every step of an auton against the match clock.  Motions are
+ * recorded from when they're set to when they exit, with how they exited and
+ * how long they spent settling (from first getting inside the big exit error
+ * to exiting).  Mechanism calls are recorded when they happen.  Anything in
+ * between, like pros::delay(), shows up as waiting.
+ *
+ * The report sorts the steps by how long they took and shows how much of the
+ * budget is left over, it prints to the terminal and saves to
+ * /usd/auton_timing.txt.
+ */
+
+/**
+ * Starts timing an auton.  Clears the last run.
+ *
+ * \param budget
+ *        How long the auton has in ms, 15000 for a match
+ */
+void autonTimerStart(int budget = 15000);
+
+/**
+ * Changes the budget of the run that's being timed, ie. 60000 for skills.
+ *
+ * \param budget
+ *        How long the auton has in ms
+ */
+void autonTimerBudgetSet(int budget);
+
+/**
+ * Returns how many ms of the budget are left, 0 once it runs out.  Always the
+ * whole budget if an auton isn't being timed.
+ */
+int autonTimerRemaining();
+
+/**
+ * Records the start of a motion.  A motion that's still going gets cut off
+ * here.  Called by the motion wrappers in motion.hpp.
+ *
+ * \param name
+ *        What the motion is, ie. "drive 24.0in"
+ */
+void autonTimerMotion(std::string name);
+
+/**
+ * Records the end of the current motion.
+ *
+ * \param exit
+ *        How the motion exited
+ * \param settle
+ *        Time in ms it spent settling
+ */
+void autonTimerMotionEnd(ez::exit_output exit, int settle);
+
+/**
+ * Records a mechanism call, ie. "clampMogo".
+ *
+ * \param name
+ *        What was called
+ */
+void autonTimerEvent(std::string name);
+
+/**
+ * Stops timing, then prints and saves the report.  Does nothing if an auton
+ * isn't being timed.
+ */
+void autonTimerReport();
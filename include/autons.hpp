@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EZ-Template/auton.hpp"
 #include "EZ-Template/drive/drive.hpp"
 
 extern Drive chassis;
@@ -23,4 +24,8 @@ void redElimPositive();
 void blueElimNegative();
 void blueElimPositive();
 
-void default_constants();
\ No newline at end of file
+void skills();
+std::vector<ez::Auton> skillsCheckpoints();
+
+void default_constants();
+void autonSplines();
\ No newline at end of file
@@ -1 +1 @@
-void autonTestor();
\ No newline at end of file
+void autonTestor(InputReader& input);
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+/**
+ * Straight line motion profiles worked out by the compiler.  Each one is a
+ * table of where the robot should be and how fast it should be going every
+ * 10ms, stored as read only data in the program, so driving one doesn't make
+ * anything at runtime, touch the heap or need the SD card.
+ *
+ * Profiles are trapezoids (accelerate, cruise, slow down) unless a jerk limit
+ * is given, then the trapezoid is smoothed with a moving average as long as
+ * it takes to reach full acceleration at that jerk, which makes an S-curve
+ * that covers the same distance.
+ *
+ * Add profiles to BAKED_PROFILES in profiles.hpp and drive them with
+ * profileDriveSet(bakedProfile("name")) or co::profile().
+ */
+
+// Time between samples, the executor's cycle
+constexpr double PROFILE_DT = 0.01;
+
+/**
+ * One sample of a profile.
+ */
+struct ProfileSample {
+  float position;  // Inches from the start
+  float velocity;  // Inches per second
+};
+
+/**
+ * Limits for a profile.  Distances in inches, times in seconds.
+ */
+struct ProfileSpec {
+  double distance;
+  double max_velocity;
+  double max_accel;
+  double max_jerk = 0;  // 0 for a trapezoid
+};
+
+/**
+ * A baked profile by name, what autons hold on to.
+ */
+struct BakedProfile {
+  const char* name;
+  const ProfileSample* samples;
+  int size;
+};
+
+namespace profile_detail {
+constexpr double sqrt(double value) {
+  if (value <= 0) return 0;
+  double guess = value > 1 ? value : 1;
+  for (int i = 0; i < 64; i++) guess = (guess + value / guess) / 2;
+  return guess;
+}
+
+constexpr int ceil(double value) {
+  int whole = (int)value;
+  return whole < value ? whole + 1 : whole;
+}
+
+// Peak speed, never more than the distance allows
+constexpr double peak(ProfileSpec spec) {
+  double reachable = sqrt(spec.distance * spec.max_accel);
+  return reachable < spec.max_velocity ? reachable : spec.max_velocity;
+}
+
+constexpr double trapezoidTime(ProfileSpec spec) {
+  double v = peak(spec);
+  return 2 * v / spec.max_accel + (spec.distance - v * v / spec.max_accel) / v;
+}
+
+// Samples the moving average covers
+constexpr int window(ProfileSpec spec) {
+  if (spec.max_jerk <= 0) return 1;
+  int samples = (int)(spec.max_accel / spec.max_jerk / PROFILE_DT + 0.5);
+  return samples < 1 ? 1 : samples;
+}
+
+// Position and velocity of the trapezoid at a time
+constexpr ProfileSample trapezoid(ProfileSpec spec, double t) {
+  double v = peak(spec);
+  double ramp = v / spec.max_accel;
+  double total = trapezoidTime(spec);
+  if (t <= 0) return {0, 0};
+  if (t >= total) return {(float)spec.distance, 0};
+  if (t < ramp) return {(float)(spec.max_accel * t * t / 2), (float)(spec.max_accel * t)};
+  if (t > total - ramp) {
+    double left = total - t;
+    return {(float)(spec.distance - spec.max_accel * left * left / 2), (float)(spec.max_accel * left)};
+  }
+  return {(float)(v * ramp / 2 + v * (t - ramp)), (float)v};
+}
+}  // namespace profile_detail
+
+/**
+ * Number of samples in a profile, the last one is at rest at the end.
+ */
+constexpr int profileLength(ProfileSpec spec) {
+  return profile_detail::ceil(profile_detail::trapezoidTime(spec) / PROFILE_DT) + profile_detail::window(spec);
+}
+
+/**
+ * Works out a profile, ie. constexpr auto RUSH = profileBake<ProfileSpec{24, 60, 120}>();
+ */
+template <ProfileSpec spec>
+constexpr std::array<ProfileSample, profileLength(spec)> profileBake() {
+  static_assert(spec.distance > 0 && spec.max_velocity > 0 && spec.max_accel > 0, "profiles need a distance, speed and acceleration");
+  constexpr int window = profile_detail::window(spec);
+  std::array<ProfileSample, profileLength(spec)> samples{};
+  for (int i = 0; i < (int)samples.size(); i++) {
+    // Averaging the position averages the velocity along with it, so the end stays put
+    double position = 0, velocity = 0;
+    for (int j = 0; j < window; j++) {
+      ProfileSample sample = profile_detail::trapezoid(spec, (i - j) * PROFILE_DT);
+      position += sample.position;
+      velocity += sample.velocity;
+    }
+    samples[i] = {(float)(position / window), (float)(velocity / window)};
+  }
+  return samples;
+}
+
+/**
+ * Wraps a baked table with its name for BAKED_PROFILES.
+ */
+template <std::size_t N>
+constexpr BakedProfile profileNamed(const char* name, const std::array<ProfileSample, N>& samples) {
+  return {name, samples.data(), (int)N};
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "EZ-Template/piston.hpp"
+#include "pros/adi.hpp"
+
+/**
+ * Wraps a pros::adi::DigitalOut (or an ez::Piston) and only writes to the
+ * device when the value actually changes.  set_value() just remembers what
+ * you asked for, flush() does the write, so setting a piston a few times in
+ * one cycle only costs one write.
+ */
+class CachedDigitalOut {
+ public:
+  /**
+   * CachedDigitalOut constructor.
+   *
+   * \param port
+   *        ADI port, 1-8 or 'A'-'H'
+   * \param init_state
+   *        Starting state of the output
+   */
+  CachedDigitalOut(std::uint8_t port, bool init_state = false);
+
+  /**
+   * CachedDigitalOut constructor for an ez::Piston.
+   *
+   * \param piston
+   *        Piston to write to, has to outlive this
+   */
+  CachedDigitalOut(ez::Piston& piston);
+
+  /**
+   * Sets the output.  The write happens on the next flush().
+   *
+   * \param value
+   *        True or false
+   */
+  void set_value(bool value);
+
+  /**
+   * Returns the last value that was set.
+   */
+  bool get_value();
+
+  /**
+   * Writes to the device if the value changed since the last write.
+   */
+  void flush();
+
+  /**
+   * Returns how many writes actually went to the device.
+   */
+  int writes_get();
+
+  /**
+   * Returns how many set_value() calls didn't need a write.
+   */
+  int suppressed_get();
+
+  /**
+   * Flushes every CachedDigitalOut, call this once per cycle.
+   */
+  static void flush_all();
+
+  /**
+   * Prints writes and suppressed writes for every CachedDigitalOut to the terminal.
+   */
+  static void stats_print();
+
+ private:
+  std::optional<pros::adi::DigitalOut> output;
+  ez::Piston* piston = nullptr;
+  std::uint8_t port = 0;
+  std::atomic<bool> target;
+  bool written;
+  std::atomic<int> requests{0};
+  std::atomic<int> writes{0};
+  static std::vector<CachedDigitalOut*>& all();
+};
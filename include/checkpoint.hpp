@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "EZ-Template/auton.hpp"
+
+/**
+ * One piece of a long route that can be started from on its own.
+ */
+struct Checkpoint {
+  std::string name;
+  double x;        // Where the robot is when this piece starts, in inches from
+  double y;        // where the route starts, +y is forward at the start
+  double heading;  // Heading in degrees, the IMU is set to this when starting here
+  bool clamped;    // If the robot is holding a mogo here
+  bool intake;     // If the intake is running here
+  std::function<void()> run;
+};
+
+/**
+ * A long route, ie. skills, broken into checkpoints.  It can be started from
+ * any checkpoint by putting the robot at that checkpoint's pose, so one
+ * piece can be worked on without running everything before it.
+ *
+ * How long each piece takes is added to a csv on the SD card as soon as it
+ * finishes and printed next to the best time so far.
+ */
+class CheckpointRoute {
+ public:
+  /**
+   * CheckpointRoute constructor.
+   *
+   * \param name
+   *        Name for the selector and the csv file, ie. "skills"
+   * \param checkpoints
+   *        Pieces of the route in order
+   */
+  CheckpointRoute(std::string name, std::vector<Checkpoint> checkpoints);
+
+  /**
+   * Runs the route from a checkpoint to the end.
+   *
+   * \param from
+   *        Index of the checkpoint to start at, 0 is the whole route
+   */
+  void run(int from = 0);
+
+  /**
+   * Returns a selector entry for every checkpoint, "<name> from <checkpoint>".
+   * The first checkpoint is left out, that's the whole route.
+   */
+  std::vector<ez::Auton> autons();
+
+ private:
+  std::string name;
+  std::vector<Checkpoint> checkpoints;
+  void setup(Checkpoint& checkpoint);
+  std::string path();
+  std::map<std::string, int> bestLoad();
+  void record(Checkpoint& checkpoint, int time, std::map<std::string, int>& best);
+};
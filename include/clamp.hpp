@@ -1,5 +1,6 @@
-void clampControl();
+bool clampPressed();
+void clampToggle();
 
 void clampMogo();
 
-void unclampMogo();
\ No newline at end of file
+void unclampMogo();
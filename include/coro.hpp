@@ -0,0 +1,371 @@
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+#include "EZ-Template/drive/drive.hpp"
+#include "motion.hpp"
+#include "okapi/api/units/QAngle.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "pros/rtos.hpp"
+
+/**
+ * Coroutine autons.  A co::Task can co_await chassis motions, delays and
+ * conditions, and tasks can run side by side with co::whenAll() and
+ * co::whenAny(), all on the auton's own pros task.
+ *
+ * \code
+ * co::Task route() {
+ *   co_await co::drive(24_in, 110);
+ *   // clamp the mogo once the drive gets close, or after a second at most
+ *   co_await co::whenAny(co::drive(-20_in, 50), co::after(co::until(driveErrorBelow(2)), clampMogo), co::delay(1000));
+ * }
+ * void auton() { co::run(route()); }
+ * \endcode
+ *
+ * co::run() ticks every ez::util::DELAY_TIME and checks whatever each task is
+ * waiting on, the same way pid_wait() checks the chassis.  Coroutine frames
+ * come out of fixed pools, so running an auton doesn't touch the heap.
+ */
+namespace co {
+
+/**
+ * Gets memory for a coroutine frame from the pools.
+ */
+void* frameAlloc(std::size_t size);
+
+/**
+ * Gives a coroutine frame back to the pools.
+ */
+void frameFree(void* frame, std::size_t size);
+
+/**
+ * A coroutine.  It doesn't start until it's awaited, passed to whenAll() /
+ * whenAny() or run with co::run().
+ */
+class Task {
+ public:
+  struct promise_type {
+    std::coroutine_handle<> continuation;
+
+    Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    // Goes back to whatever awaited this task when it finishes
+    struct FinalAwaiter {
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+        std::coroutine_handle<> next = handle.promise().continuation;
+        return next ? next : std::noop_coroutine();
+      }
+      void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+
+    static void* operator new(std::size_t size) { return frameAlloc(size); }
+    static void operator delete(void* frame, std::size_t size) { frameFree(frame, size); }
+  };
+
+  Task() = default;
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+  Task(Task&& other) : handle(std::exchange(other.handle, nullptr)) {}
+  Task& operator=(Task&& other) {
+    if (this != &other) {
+      if (handle) handle.destroy();
+      handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+  }
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  ~Task() {
+    if (handle) handle.destroy();
+  }
+
+  /**
+   * Returns true once the task has finished.
+   */
+  bool done() { return !handle || handle.done(); }
+
+  /**
+   * Returns the coroutine frame.
+   */
+  void* address() { return handle ? handle.address() : nullptr; }
+
+  /**
+   * Runs the task until it first has to wait.
+   */
+  void start() {
+    if (!done()) handle.resume();
+  }
+
+  // Awaiting a task runs it in place of the awaiting one until it finishes
+  bool await_ready() { return done(); }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+    handle.promise().continuation = awaiting;
+    return handle;
+  }
+  void await_resume() {}
+
+ private:
+  std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * Something a task can wait on.  The scheduler calls ready() once per tick
+ * and resumes the task once it returns true.
+ */
+class Waiter {
+ public:
+  Waiter() = default;
+  Waiter(const Waiter&) {}
+  Waiter& operator=(const Waiter&) { return *this; }
+  virtual ~Waiter();
+
+  /**
+   * Returns true once the task can carry on.
+   */
+  virtual bool ready() = 0;
+
+  /**
+   * whenAll() and whenAny() return true so they're checked before anything
+   * else, as soon as one of their tasks finishes.
+   */
+  virtual bool combinator() { return false; }
+
+  void await_suspend(std::coroutine_handle<> awaiting) { wait(awaiting); }
+
+ private:
+  friend void tick();
+  std::coroutine_handle<> handle;
+  bool waiting = false;
+  unsigned polled = 0;
+  void wait(std::coroutine_handle<> awaiting);
+  void unwait();
+};
+
+/**
+ * Checks everything that's waiting and resumes what's ready.  co::run() calls
+ * this every ez::util::DELAY_TIME.
+ */
+void tick();
+
+/**
+ * Runs a task until it finishes.  Blocks, so it can be used as an auton.
+ *
+ * \param task
+ *        Task to run
+ */
+void run(Task task);
+
+/**
+ * Waits for a time.
+ */
+class Delay : public Waiter {
+ public:
+  explicit Delay(int time) : time(time) {}
+  bool await_ready() {
+    end = pros::millis() + time;
+    return time <= 0;
+  }
+  void await_resume() {}
+  bool ready() override { return (int)pros::millis() >= end; }
+
+ private:
+  int time;
+  int end = 0;
+};
+
+/**
+ * Waits until a condition is true.
+ */
+template <class Condition>
+class Until : public Waiter {
+ public:
+  explicit Until(Condition condition) : condition(std::move(condition)) {}
+  bool await_ready() { return condition(); }
+  void await_resume() {}
+  bool ready() override { return condition(); }
+
+ private:
+  Condition condition;
+};
+
+/**
+ * Runs a chassis motion and waits for it to exit, like pid_wait().  Returns
+ * how it exited, or ez::RUNNING if another motion took over first.
+ */
+class Motion : public Waiter {
+ public:
+  enum Type { DRIVE,
+              TURN,
+              TURN_RELATIVE,
+              SWING,
+              PROFILE,
+              PATH };
+
+  Motion(Type type, double target, int speed, ez::e_swing side = ez::LEFT_SWING, int opposite_speed = 0)
+      : type(type), target(target), speed(speed), side(side), opposite_speed(opposite_speed) {}
+  Motion(BakedProfile profile, bool backwards)
+      : type(PROFILE), target(0), speed(0), side(ez::LEFT_SWING), opposite_speed(0), profile(profile), backwards(backwards) {}
+  Motion(const Path& path, int speed, bool backwards)
+      : type(PATH), target(0), speed(speed), side(ez::LEFT_SWING), opposite_speed(0), path(&path), backwards(backwards) {}
+  bool await_ready();
+  ez::exit_output await_resume() { return exit; }
+  bool ready() override;
+
+ private:
+  Type type;
+  double target;
+  int speed;
+  ez::e_swing side;
+  int opposite_speed;
+  BakedProfile profile = {nullptr, nullptr, 0};
+  const Path* path = nullptr;
+  bool backwards = false;
+  unsigned id = 0;
+  ez::exit_output exit = ez::RUNNING;
+  MotionWait motion_wait;
+};
+
+/**
+ * Waits on several awaitables at once.  Finishes when all of them have.
+ */
+template <std::size_t N>
+class WhenAll : public Waiter {
+ public:
+  explicit WhenAll(std::array<Task, N> tasks) : tasks(std::move(tasks)) {}
+  bool combinator() override { return true; }
+  bool await_ready() {
+    for (auto& task : tasks) task.start();
+    return ready();
+  }
+  void await_resume() {}
+  bool ready() override {
+    for (auto& task : tasks) {
+      if (!task.done()) return false;
+    }
+    return true;
+  }
+
+ private:
+  std::array<Task, N> tasks;
+};
+
+/**
+ * Waits on several awaitables at once.  Finishes when the first one does and
+ * drops the rest.  Returns the index of the one that finished.
+ */
+template <std::size_t N>
+class WhenAny : public Waiter {
+ public:
+  explicit WhenAny(std::array<Task, N> tasks) : tasks(std::move(tasks)) {}
+  bool combinator() override { return true; }
+  bool await_ready() {
+    for (auto& task : tasks) {
+      task.start();
+      if (task.done()) return true;
+    }
+    return false;
+  }
+  int await_resume() {
+    for (std::size_t i = 0; i < N; i++) {
+      if (tasks[i].done()) return i;
+    }
+    return -1;
+  }
+  bool ready() override {
+    for (auto& task : tasks) {
+      if (task.done()) return true;
+    }
+    return false;
+  }
+
+ private:
+  std::array<Task, N> tasks;
+};
+
+/**
+ * Turns any awaitable into a task.
+ */
+template <class Awaitable>
+Task wrap(Awaitable awaitable) {
+  co_await awaitable;
+}
+inline Task wrap(Task task) { return task; }
+
+/**
+ * Waits for a time in ms.
+ */
+inline Delay delay(int time) { return Delay(time); }
+
+/**
+ * Waits until a condition is true, ie. co::until(driveErrorBelow(2)).
+ */
+template <class Condition>
+Until<Condition> until(Condition condition) { return Until<Condition>(std::move(condition)); }
+
+/**
+ * Runs a function once an awaitable finishes, ie. co::after(co::delay(400), intakeOn).
+ */
+template <class Awaitable>
+Task after(Awaitable awaitable, void (*callback)()) {
+  co_await awaitable;
+  callback();
+}
+
+/**
+ * Drives like driveSet() and waits for it to exit.
+ */
+inline Motion drive(okapi::QLength target, int speed) { return Motion(Motion::DRIVE, target.convert(okapi::inch), speed); }
+
+/**
+ * Turns like turnSet() and waits for it to exit.
+ */
+inline Motion turn(okapi::QAngle target, int speed) { return Motion(Motion::TURN, target.convert(okapi::degree), speed); }
+
+/**
+ * Turns like turnRelativeSet() and waits for it to exit.
+ */
+inline Motion turnRelative(okapi::QAngle target, int speed) { return Motion(Motion::TURN_RELATIVE, target.convert(okapi::degree), speed); }
+
+/**
+ * Swings like swingSet() and waits for it to exit.
+ */
+inline Motion swing(ez::e_swing side, okapi::QAngle target, int speed, int opposite_speed = 0) { return Motion(Motion::SWING, target.convert(okapi::degree), speed, side, opposite_speed); }
+
+/**
+ * Drives a baked profile like profileDriveSet() and waits for it to exit.
+ */
+inline Motion profile(BakedProfile profile, bool backwards = false) { return Motion(profile, backwards); }
+
+/**
+ * Follows a path like odomPathSet() and waits for it to exit.  The path has
+ * to outlive the motion, ie. one from splineGet().
+ */
+inline Motion path(const Path& path, int speed, bool backwards = false) { return Motion(path, speed, backwards); }
+
+/**
+ * Runs every awaitable side by side and waits for all of them.
+ */
+template <class... Awaitables>
+WhenAll<sizeof...(Awaitables)> whenAll(Awaitables... awaitables) {
+  return WhenAll<sizeof...(Awaitables)>({wrap(std::move(awaitables))...});
+}
+
+/**
+ * Runs every awaitable side by side and waits for the first one.  The co_await
+ * gives back the index of the one that finished.
+ */
+template <class... Awaitables>
+WhenAny<sizeof...(Awaitables)> whenAny(Awaitables... awaitables) {
+  return WhenAny<sizeof...(Awaitables)>({wrap(std::move(awaitables))...});
+}
+
+}  // namespace co
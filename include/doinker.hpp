@@ -1 +1,3 @@
-void doinkerControl();
\ No newline at end of file
+bool doinkerPressed();
+void doinkerToggle();
+void doinkerSet(bool value);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "loop_timer.hpp"
+#include "profiler.hpp"
+#include "pros/rtos.hpp"
+
+/**
+ * Which competition modes a job runs in.  Jobs for driver control read the
+ * controller, jobs like the lift score sequence have to run in both.
+ */
+enum e_run_mode { RUN_DISABLED = 0,
+                  RUN_OPCONTROL = 1,
+                  RUN_AUTONOMOUS = 2,
+                  RUN_ALWAYS = 3 };
+
+/**
+ * Runs each subsystem in its own task with its own rate and priority, so one
+ * slow subsystem can't hold up the drive.
+ */
+class Executor {
+ public:
+  /**
+   * Adds a job that runs every period.
+   *
+   * \param name
+   *        Name of the job, shows up in the stats
+   * \param callback
+   *        Function to run
+   * \param period
+   *        Time between runs in ms
+   * \param priority
+   *        RTOS priority, TASK_PRIORITY_DEFAULT plus/minus 1 or 2
+   * \param modes
+   *        Which modes this job runs in, RUN_OPCONTROL, RUN_AUTONOMOUS or RUN_ALWAYS
+   */
+  void add(std::string name, std::function<void()> callback, int period, int priority = TASK_PRIORITY_DEFAULT, int modes = RUN_OPCONTROL);
+
+  /**
+   * Adds a job that only runs when something changes, ie. a button press.
+   * The trigger is checked every ez::util::DELAY_TIME.
+   *
+   * \param name
+   *        Name of the job, shows up in the stats
+   * \param trigger
+   *        Returns true when the callback should run
+   * \param callback
+   *        Function to run
+   * \param priority
+   *        RTOS priority, TASK_PRIORITY_DEFAULT plus/minus 1 or 2
+   * \param modes
+   *        Which modes this job runs in, RUN_OPCONTROL, RUN_AUTONOMOUS or RUN_ALWAYS
+   */
+  void add_on_change(std::string name, std::function<bool()> trigger, std::function<void()> callback, int priority = TASK_PRIORITY_DEFAULT, int modes = RUN_OPCONTROL);
+
+  /**
+   * Starts a task for every job added so far.
+   */
+  void start();
+
+  /**
+   * Sets the current mode, only jobs for this mode will run.
+   */
+  void mode_set(e_run_mode mode);
+
+  /**
+   * Returns the current mode.
+   */
+  e_run_mode mode_get();
+
+  /**
+   * Returns the loop timer for a job, or nullptr if there isn't one.
+   */
+  LoopTimer* timer_get(std::string name);
+
+  /**
+   * Prints the loop stats of every job to the terminal.
+   */
+  void stats_print();
+
+ private:
+  struct Job {
+    std::string name;
+    std::function<void()> callback;
+    std::function<bool()> trigger;
+    int period;
+    int priority;
+    int modes;
+    LoopTimer timer;
+    Histogram* histogram;  // how long the callback takes, see profiler.hpp
+    bool started = false;
+  };
+  std::vector<std::unique_ptr<Job>> jobs;
+  std::atomic<int> mode{RUN_DISABLED};
+  void job_task(Job* job);
+};
+
+extern Executor executor;
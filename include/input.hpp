@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "pros/misc.hpp"
+
+// Held for the tool chords in opcontrol(), ie. UP+DOWN for the latency test
+const pros::controller_digital_e_t INPUT_CHORD = pros::E_CONTROLLER_DIGITAL_UP;
+
+/**
+ * Whether a reader sees buttons pressed along with INPUT_CHORD.
+ */
+enum input_chords { CHORDS_HIDDEN,
+                    CHORDS_SEEN };
+
+/**
+ * Every button and joystick on the master controller, sampled once per cycle.
+ */
+struct InputSnapshot {
+  std::uint32_t time = 0;              // pros::millis() when it was sampled
+  std::uint16_t held = 0;              // one bit per button, L1 is bit 0 and A is bit 11
+  std::int8_t analog[4] = {0, 0, 0, 0};  // LEFT_X, LEFT_Y, RIGHT_X, RIGHT_Y
+};
+
+/**
+ * Samples the controller into the shared snapshot.  Runs once per cycle from
+ * the executor, nothing else should read the controller directly.
+ */
+void inputUpdate();
+
+/**
+ * Feeds snapshots into inputUpdate() instead of the controller, ie. to play
+ * back a recording.  The source is called once per cycle and is dropped once
+ * it returns false.
+ *
+ * \param source
+ *        Fills in the next snapshot, returns false when there are no more
+ */
+void inputSourceSet(std::function<bool(InputSnapshot&)> source);
+
+/**
+ * Returns true while a source set with inputSourceSet() is still going.
+ */
+bool inputSourceActive();
+
+/**
+ * Returns the most recent snapshot.
+ */
+InputSnapshot inputLatest();
+
+/**
+ * Returns true while INPUT_CHORD is held, for code that still reads the
+ * controller itself.
+ */
+bool inputChordHeld();
+
+/**
+ * Returns the bit for a button in InputSnapshot::held.
+ */
+std::uint16_t inputButtonBit(pros::controller_digital_e_t button);
+
+/**
+ * Reads the shared snapshot for one subsystem.  Each subsystem keeps its own
+ * reader so presses and releases are found against the last snapshot that
+ * subsystem saw, even if it runs slower than the controller is sampled.
+ *
+ * Subsystems don't see INPUT_CHORD, or any button that was down while it was
+ * held until that button is let go, so a chord never also runs whatever the
+ * button normally does.
+ */
+class InputReader {
+ public:
+  /**
+   * InputReader constructor.
+   *
+   * \param chords
+   *        CHORDS_SEEN for opcontrol(), which handles the chords
+   */
+  explicit InputReader(input_chords chords = CHORDS_HIDDEN);
+
+  /**
+   * Grabs the latest snapshot.  Call this once at the start of every cycle so
+   * everything in the cycle sees the same buttons.
+   */
+  void update();
+
+  /**
+   * Returns true while the button is held.
+   */
+  bool held(pros::controller_digital_e_t button);
+
+  /**
+   * Returns true on the cycle the button goes down.
+   */
+  bool pressed(pros::controller_digital_e_t button);
+
+  /**
+   * Returns true on the cycle the button comes up.
+   */
+  bool released(pros::controller_digital_e_t button);
+
+  /**
+   * Returns the joystick value, -127 to 127.
+   */
+  int analog(pros::controller_analog_e_t axis);
+
+  /**
+   * Returns the snapshot this cycle is using.
+   */
+  InputSnapshot snapshot();
+
+ private:
+  InputSnapshot current;
+  std::uint16_t last_held = 0;
+  input_chords chords;
+  std::uint16_t chord_held = 0;  // Buttons that belong to a chord until they come up
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * Measures how long it takes from the brain seeing a joystick move to the
+ * drive being commanded and to the drive motors actually moving.  Each push
+ * from rest is one sample, results go into the "latency cmd" and
+ * "latency motor" histograms (1ms buckets) and print with profilerPrint().
+ *
+ * The time the controller radio takes to get the input to the brain happens
+ * before the snapshot is taken, so it isn't in these numbers.
+ */
+
+/**
+ * Runs the measurement, call every few ms from the executor.
+ */
+void latencyIterate();
+
+/**
+ * Turns latency measuring on and off.  Turning it off prints the results.
+ */
+void latencyToggle();
+
+/**
+ * Returns true if latency measuring is on.
+ */
+bool latencyEnabled();
@@ -2,7 +2,15 @@ void liftControl();
 
 void liftDown();
 void liftLoad();
+
+// starts scoring in the background, the chassis can keep driving
 void liftScore();
+void liftScoreIterate();
+bool liftScoreDone();
+bool liftScoreUsingIntake();
+void liftScoreCancel();
+// something else is running the intake, the score leaves it alone from here
+void liftScoreIntakeRelease();
 
 void intakeUp();
-void intakeDown();
\ No newline at end of file
+void intakeDown();
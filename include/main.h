@@ -46,6 +46,25 @@
 // More includes here...
 #include "autons.hpp"
 #include "subsystems.hpp"
+#include "macro.hpp"
+#include "loop_timer.hpp"
+#include "profiler.hpp"
+#include "executor.hpp"
+#include "input.hpp"
+#include "latency.hpp"
+#include "auton_timer.hpp"
+#include "recorder.hpp"
+#include "autotune.hpp"
+#include "odom.hpp"
+#include "path.hpp"
+#include "spline.hpp"
+#include "baked_profile.hpp"
+#include "profiles.hpp"
+#include "odom_motion.hpp"
+#include "motion.hpp"
+#include "action_graph.hpp"
+#include "coro.hpp"
+#include "checkpoint.hpp"
 #include "intake.hpp"
 #include "clamp.hpp"
 #include "lift.hpp"
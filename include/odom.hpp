@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * Tracks where the robot is on the field, (x, y, theta), so autons don't have
+ * to stack up relative moves.
+ *
+ * Every 10ms the "odom" executor job takes the heading from the IMU and how
+ * far the robot went from the drive sensors, and adds the arc between the
+ * last heading and this one to the pose.  The drive sensors are whatever
+ * chassis.drive_sensor_left() and drive_sensor_right() read, so building the
+ * chassis with tracking wheels or rotation sensors makes odometry use them
+ * too.
+ *
+ * The job runs above every other task, and readers copy the pose out under a
+ * sequence number instead of a mutex, so odomGet() never waits and never
+ * holds the job up.
+ *
+ * Reset the drive sensors and IMU with odomSensorsReset() and odomImuReset()
+ * instead of the chassis' own, so the job knows the readings jumped instead
+ * of counting the jump as the robot moving.
+ */
+
+/**
+ * Where the robot is.  x and y are in inches, theta is in degrees like the
+ * IMU, clockwise positive and 0 facing +y.
+ */
+struct Pose {
+  double x = 0;
+  double y = 0;
+  double theta = 0;
+};
+
+/**
+ * One set of sensor readings for odomUpdate().
+ */
+struct OdomSample {
+  double left = 0;              // Inches, like chassis.drive_sensor_left()
+  double right = 0;             // Inches, like chassis.drive_sensor_right()
+  double imu = 0;               // Degrees, like chassis.drive_imu_get()
+  bool sensors_reset = false;   // The drive sensors were reset right after the last sample
+  bool imu_reset = false;       // The IMU was reset right after the last sample
+};
+
+/**
+ * Updates the pose from the sensors, and does any reset that's been asked
+ * for.  Runs from the executor.
+ */
+void odomIterate();
+
+/**
+ * Updates the pose from one set of readings.  odomIterate() feeds it the
+ * chassis' sensors, the sim tests feed it recorded traces.
+ *
+ * \param sample
+ *        Readings this cycle
+ */
+void odomUpdate(OdomSample sample);
+
+/**
+ * chassis.drive_sensor_reset() that odometry knows about.  The odom job does
+ * the reset between two of its reads, so it doesn't move the pose.
+ */
+void odomSensorsReset();
+
+/**
+ * chassis.drive_imu_reset() that odometry knows about, see odomSensorsReset().
+ *
+ * \param heading
+ *        What the IMU reads after the reset
+ */
+void odomImuReset(double heading = 0);
+
+/**
+ * Returns the latest pose.  Safe to call from any task.
+ */
+Pose odomGet();
+
+/**
+ * Moves the pose, ie. to where a checkpoint starts.  Waits for the next
+ * odometry cycle to pick it up, so odomGet() right after returns the new pose.
+ *
+ * \param pose
+ *        Where the robot is now
+ */
+void odomSet(Pose pose);
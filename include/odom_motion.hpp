@@ -0,0 +1,96 @@
+#pragma once
+
+#include "EZ-Template/util.hpp"
+#include "baked_profile.hpp"
+#include "path.hpp"
+
+/**
+ * Motions to a spot on the field using the pose from odom.hpp, so a
+ * turn, drive, turn can be one motion with one settle at the end.  See
+ * odomPointSet() and odomPoseSet() in motion.hpp.
+ *
+ * A pose motion chases a carrot, a point that starts back along the final
+ * heading and slides into the target as the robot gets closer (boomerang).
+ * That curves the robot in so it arrives facing the right way.  The "odom
+ * motion" executor job drives the chassis while one of these is running, and
+ * pidWait(), MotionWait and the auton timer treat them like any other motion.
+ *
+ * A path motion follows a Path with pure pursuit: every cycle it finds the
+ * closest point and where a 12in circle around the robot crosses the path
+ * ahead of it, then drives the arc through that point.  Both searches pick up
+ * from last cycle's answer, so a long path costs the same per cycle as a
+ * short one.  Once the end is inside the circle it settles on the last point.
+ *
+ * A profile motion drives straight along the heading it started at, chasing
+ * a baked profile's position 10ms at a time with the profile's speed fed
+ * forward, then settles like a drive once the table runs out.
+ *
+ * The drive PID's constants and exit conditions are used for distance, the
+ * turn PID's for heading.  Starting any EZ motion stops these.
+ */
+
+/**
+ * Starts an odom motion.  Autons use odomPointSet() and odomPoseSet() from
+ * motion.hpp, which mirror and time it.
+ *
+ * \param x
+ *        Field x in inches
+ * \param y
+ *        Field y in inches
+ * \param theta
+ *        Heading to end at in degrees, only used when pose is true
+ * \param pose
+ *        True to end at theta, false to just get to the point
+ * \param speed
+ *        Most power, out of 127
+ * \param backwards
+ *        Drive there with the back of the robot
+ */
+void odomMotionStart(double x, double y, double theta, bool pose, int speed, bool backwards);
+
+/**
+ * Starts following a path.  Autons use odomPathSet() from motion.hpp.
+ *
+ * \param path
+ *        Path to follow, copied
+ * \param speed
+ *        Most power, out of 127.  Bends and the end slow it down further
+ * \param backwards
+ *        Follow it with the back of the robot
+ */
+void odomPathStart(const Path& path, int speed, bool backwards);
+
+/**
+ * Starts driving a baked profile.  Autons use profileDriveSet() from
+ * motion.hpp.
+ *
+ * \param profile
+ *        Profile from bakedProfile()
+ * \param backwards
+ *        Drive it with the back of the robot
+ */
+void odomProfileStart(const BakedProfile& profile, bool backwards);
+
+/**
+ * Drives the current odom motion, runs from the executor.
+ */
+void odomMotionIterate();
+
+/**
+ * Returns true while an odom motion is running.
+ */
+bool odomMotionRunning();
+
+/**
+ * Checks the odom motion's exit conditions once, like PID::exit_condition().
+ * Stops the motion once it exits.
+ *
+ * \param print
+ *        Print how it exited
+ */
+ez::exit_output odomMotionExit(bool print = false);
+
+/**
+ * Returns how far in inches the robot is from the odom motion's target.
+ */
+double odomMotionError();
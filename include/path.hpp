@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * A path for pure pursuit, see odomPathSet() in motion.hpp.
+ *
+ * The waypoints are filled in to a point every inch or so, and each point
+ * gets how far along the path it is and the most power it can take, from
+ * how tight the path bends there and how hard the robot can slow down for
+ * the next bend.  Points are stored as one array per field instead of an
+ * array of structs, so walking along the path each tick reads memory in
+ * order.
+ */
+class Path {
+ public:
+  /**
+   * A point to drive through, in field inches like odomGet().
+   */
+  struct Waypoint {
+    double x;
+    double y;
+  };
+
+  /**
+   * Path constructor.
+   *
+   * \param waypoints
+   *        Points to drive through in order, the first one is normally where the robot is
+   * \param spacing
+   *        Inches between the filled in points
+   */
+  Path(std::vector<Waypoint> waypoints, double spacing = 1.0);
+
+  /**
+   * Path through points that are already filled in, ie. from a spline.  The
+   * distances and speeds are worked out from them.
+   *
+   * \param x
+   *        Point x's, in field inches
+   * \param y
+   *        Point y's, same length as x or the path is empty
+   */
+  Path(std::vector<double> x, std::vector<double> y);
+
+  /**
+   * Returns the number of points.
+   */
+  int size() const;
+
+  /**
+   * Returns the path flipped across the field, for mirrorSet().
+   */
+  Path mirrored() const;
+
+  /**
+   * Finds the point closest to the robot, starting from the last closest one.
+   * The search only walks forward a few points, so it costs the same on any
+   * length of path.
+   *
+   * \param px
+   *        Robot x
+   * \param py
+   *        Robot y
+   * \param from
+   *        Last closest point, 0 at the start
+   */
+  int closest(double px, double py, int from) const;
+
+  /**
+   * Finds where a circle around the robot crosses the path, starting from the
+   * last crossing so the lookahead only ever moves forward.  Returns false and
+   * leaves the lookahead alone if the circle doesn't cross the path ahead.
+   *
+   * \param px
+   *        Robot x
+   * \param py
+   *        Robot y
+   * \param radius
+   *        Lookahead distance
+   * \param index
+   *        Segment the lookahead is on, from index to index + 1.  Updated
+   * \param t
+   *        How far along that segment, 0 to 1.  Updated
+   */
+  bool lookahead(double px, double py, double radius, int& index, double& t) const;
+
+  // One entry per point
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> distance;  // Inches along the path from the first point
+  std::vector<double> speed;     // Most power at this point, out of 127
+
+ private:
+  Path() = default;
+  void distancesSet();
+  void speedsSet();
+};
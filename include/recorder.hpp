@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "input.hpp"
+
+/**
+ * Records driver control to the SD card and plays it back as an auton.
+ *
+ * Every input cycle one 12 byte frame goes into a ring buffer: the controller
+ * snapshot plus what the drive, intake and lift were commanded and where the
+ * pistons were.  The "recorder" executor job writes the buffer out to
+ * /usd/rec<n>.bin at a low priority, so the SD card never holds up a control
+ * loop.  If the buffer ever fills the frame is dropped and counted.
+ *
+ * Playback feeds the recorded snapshots back into inputUpdate() one per cycle
+ * with the driver control jobs running, so the robot does what the driver
+ * did tick for tick.
+ */
+
+// Up to this many recordings, /usd/rec0.bin to /usd/rec9.bin
+const int RECORDER_SLOTS = 10;
+
+/**
+ * One cycle of a recording.
+ */
+struct RecordFrame {
+  std::uint16_t held;        // InputSnapshot::held
+  std::int8_t analog[4];     // InputSnapshot::analog
+  std::int8_t drive[2];      // left and right drive voltage, out of 127
+  std::int8_t intake;        // intake voltage, out of 127
+  std::int8_t lift;          // lift voltage, out of 127
+  std::uint8_t pistons;      // clamp, doinker and intake piston, one bit each
+  std::uint8_t reserved;
+};
+static_assert(sizeof(RecordFrame) == 12, "RecordFrame is written to the SD card as is");
+
+/**
+ * Start of every recording file.
+ */
+struct RecordHeader {
+  char magic[4];             // "REC1"
+  std::uint8_t period;       // ms between frames
+  std::uint8_t brake;        // drive brake mode while recording
+  std::uint8_t pistons;      // pistons when recording started, same bits as RecordFrame
+  std::uint8_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 8, "RecordHeader is written to the SD card as is");
+
+/**
+ * Adds the current cycle to the recording.  Called by inputUpdate() right
+ * after it samples, does nothing unless recording.
+ *
+ * \param snapshot
+ *        Snapshot that was just sampled
+ */
+void recorderCapture(const InputSnapshot& snapshot);
+
+/**
+ * Writes buffered frames to the SD card.  Runs from the executor.
+ */
+void recorderFlush();
+
+/**
+ * Starts recording to the next free slot, or stops and closes the file.
+ */
+void recorderToggle();
+
+/**
+ * Returns true while recording.
+ */
+bool recorderEnabled();
+
+/**
+ * Returns the file name for a recording slot, ie. /usd/rec3.bin.
+ *
+ * \param slot
+ *        0 to RECORDER_SLOTS - 1
+ */
+std::string recorderPath(int slot);
+
+/**
+ * Returns true if a recording exists in this slot.
+ *
+ * \param slot
+ *        0 to RECORDER_SLOTS - 1
+ */
+bool recorderExists(int slot);
+
+/**
+ * Plays a recording back.  Blocks until it's done, so it can be used as an
+ * auton.
+ *
+ * \param slot
+ *        0 to RECORDER_SLOTS - 1
+ */
+void recorderReplay(int slot);
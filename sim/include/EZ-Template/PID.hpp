@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "EZ-Template/util.hpp"
+#include "api.h"
+
+namespace ez {
+class PID {
+ public:
+  PID();
+  PID(double p, double i = 0, double d = 0, double start_i = 0, std::string name = "");
+
+  struct Constants {
+    double kp;
+    double ki;
+    double kd;
+    double start_i;
+  };
+
+  struct exit_condition_ {
+    int small_exit_time = 0;
+    double small_error = 0;
+    int big_exit_time = 0;
+    double big_error = 0;
+    int velocity_exit_time = 0;
+    int mA_timeout = 0;
+  };
+
+  void constants_set(double p, double i = 0, double d = 0, double p_start_i = 0);
+  void exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time = 0, double p_big_error = 0, int p_velocity_exit_time = 0, int p_mA_timeout = 0);
+  void target_set(double input);
+  double compute(double current);
+  double compute_error(double err, double current);
+  double target_get();
+  Constants constants_get();
+  void variables_reset();
+  void timers_reset();
+  void i_reset_toggle(bool toggle);
+  bool i_reset_get();
+  void name_set(std::string name);
+  std::string name_get();
+
+  ez::exit_output exit_condition(bool print = false);
+  ez::exit_output exit_condition(pros::Motor sensor, bool print = false);
+  ez::exit_output exit_condition(std::vector<pros::Motor> sensor, bool print = false);
+
+  Constants constants = {0, 0, 0, 0};
+  exit_condition_ exit;
+
+  double output = 0.0;
+  double cur = 0.0;
+  double error = 0.0;
+  double target = 0.0;
+  double prev_error = 0.0;
+  double prev_current = 0.0;
+  double integral = 0.0;
+  double derivative = 0.0;
+
+ private:
+  double velocity_zero_main = 0.05;
+  int i = 0, j = 0, k = 0, l = 0;
+  std::string name;
+  bool reset_i_sgn = true;
+  void exit_condition_print(ez::exit_output exit_type);
+  double raw_compute();
+};
+}  // namespace ez
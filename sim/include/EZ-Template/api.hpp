@@ -0,0 +1,14 @@
+/**
+ * Host stand-in for EZ-Template.  firmware/EZ-Template.a is ARM only, so
+ * this is the slice of EZ-Template this project uses, rebuilt in sim/src.
+ */
+
+#pragma once
+
+#include "EZ-Template/PID.hpp"
+#include "EZ-Template/auton.hpp"
+#include "EZ-Template/auton_selector.hpp"
+#include "EZ-Template/drive/drive.hpp"
+#include "EZ-Template/piston.hpp"
+#include "EZ-Template/sdcard.hpp"
+#include "EZ-Template/util.hpp"
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "EZ-Template/PID.hpp"
+#include "EZ-Template/util.hpp"
+#include "okapi/api/units/QAngle.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include "pros/motors.h"
+
+using namespace ez;
+
+namespace ez {
+/**
+ * Stand-in for ez::Drive with the same API this project calls.  The PID
+ * loops follow EZ-Template 3.1, the sensors come from the simulated world.
+ */
+class Drive {
+ public:
+  e_swing current_swing;
+  std::vector<pros::Motor> left_motors;
+  std::vector<pros::Motor> right_motors;
+
+  PID headingPID;
+  PID turnPID;
+  PID forward_drivePID;
+  PID leftPID;
+  PID rightPID;
+  PID backward_drivePID;
+  PID swingPID;
+  PID forward_swingPID;
+  PID backward_swingPID;
+
+  bool interfered = false;
+
+  Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_ports, int imu_port, double wheel_diameter, double ticks, double ratio = 1.0);
+
+  void initialize();
+
+  // Drive modes and raw output
+  void drive_mode_set(e_mode p_mode);
+  e_mode drive_mode_get();
+  void drive_set(int left, int right);
+  std::vector<int> drive_get();
+  void drive_brake_set(pros::motor_brake_mode_e_t brake_type);
+  pros::motor_brake_mode_e_t drive_brake_get();
+
+  // Sensors
+  double drive_sensor_right();
+  double drive_sensor_left();
+  void drive_sensor_reset();
+  void drive_imu_reset(double new_heading = 0);
+  double drive_imu_get();
+  void drive_imu_scaler_set(double scaler);
+  double drive_imu_scaler_get();
+  bool drive_imu_calibrate(bool run_loading_animation = true);
+  void drive_angle_set(okapi::QAngle p_angle);
+  void drive_angle_set(double angle);
+
+  // Driver control
+  void opcontrol_arcade_standard(e_type stick_type);
+  void opcontrol_curve_default_set(double left, double right = 0);
+  void opcontrol_drive_activebrake_set(double kp);
+  void opcontrol_curve_buttons_toggle(bool toggle);
+  bool opcontrol_curve_buttons_toggle_get();
+  void opcontrol_curve_buttons_left_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase);
+  void opcontrol_curve_buttons_right_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase);
+  void opcontrol_curve_buttons_iterate();
+  double opcontrol_curve_left(double x);
+  double opcontrol_curve_right(double x);
+  void opcontrol_joystick_threshold_set(int threshold);
+  void opcontrol_drive_sensors_reset();
+  void opcontrol_joystick_threshold_iterate(int l_stick, int r_stick);
+
+  // Autonomous motions
+  void pid_drive_set(okapi::QLength p_target, int speed, bool slew_on = false, bool toggle_heading = true);
+  void pid_drive_set(double target, int speed, bool slew_on = false, bool toggle_heading = true);
+  void pid_turn_set(double target, int speed, bool slew_on = false);
+  void pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on = false);
+  void pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on = false);
+  void pid_turn_relative_set(double target, int speed, bool slew_on = false);
+  void pid_swing_set(e_swing type, double target, int speed, int opposite_speed = 0, bool slew_on = false);
+  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed = 0, bool slew_on = false);
+  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed = 0, bool slew_on = false);
+  void pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed = 0, bool slew_on = false);
+  void pid_targets_reset();
+  void pid_wait();
+  void pid_wait_until(okapi::QAngle target);
+  void pid_wait_until(okapi::QLength target);
+  void pid_wait_until(double target);
+  void pid_wait_quick();
+  void pid_wait_quick_chain();
+  void pid_speed_max_set(int speed);
+  int pid_speed_max_get();
+  void pid_drive_toggle(bool toggle);
+  bool pid_drive_toggle_get();
+  void pid_print_toggle(bool toggle);
+  bool pid_print_toggle_get();
+
+  // Constants
+  void pid_drive_constants_set(double p, double i = 0.0, double d = 0.0, double p_start_i = 0.0);
+  void pid_heading_constants_set(double p, double i = 0.0, double d = 0.0, double p_start_i = 0.0);
+  void pid_turn_constants_set(double p, double i = 0.0, double d = 0.0, double p_start_i = 0.0);
+  void pid_swing_constants_set(double p, double i = 0.0, double d = 0.0, double p_start_i = 0.0);
+  void pid_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error, okapi::QTime p_big_exit_time, okapi::QLength p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu = true);
+  void pid_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu = true);
+  void pid_swing_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu = true);
+  void pid_drive_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu = true);
+  void pid_turn_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu = true);
+  void pid_swing_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu = true);
+  void pid_drive_chain_constant_set(okapi::QLength input);
+  void pid_turn_chain_constant_set(okapi::QAngle input);
+  void pid_swing_chain_constant_set(okapi::QAngle input);
+  void slew_drive_constants_set(okapi::QLength distance, int min_speed);
+
+  // PID tuner, the sim has no screen so these only keep state
+  void pid_tuner_enable();
+  void pid_tuner_disable();
+  void pid_tuner_toggle();
+  bool pid_tuner_enabled();
+  void pid_tuner_iterate();
+
+ private:
+  double wheel_diameter;
+  double wheel_rpm;
+  double imu_scaler = 1.0;
+  double imu_offset = 0;
+  e_mode mode = DISABLE;
+  int max_speed = 0;
+  int swing_opposite_speed = 0;
+  bool heading_on = true;
+  bool drive_toggle = true;
+  bool print_toggle = true;
+  bool pid_tuner_on = false;
+  bool curve_buttons = false;
+  bool drive_sensors_reset_once = false;
+  int joystick_threshold = 5;
+  int output_left = 0;
+  int output_right = 0;
+  pros::motor_brake_mode_e_t brake = pros::E_MOTOR_BRAKE_COAST;
+  bool slew_on = false;
+  double slew_distance = 0;
+  int slew_min_speed = 0;
+  double drive_chain = 0;
+  double turn_chain = 0;
+  double swing_chain = 0;
+  double l_start = 0;
+  double r_start = 0;
+  bool started = false;
+
+  void ez_auto_task();
+  void drive_pid_task();
+  void turn_pid_task();
+  void swing_pid_task();
+  void private_drive_set(int left, int right);
+  int speed_limit(double traveled);
+  void wait_print(std::string name, ez::exit_output exit);
+};
+}  // namespace ez
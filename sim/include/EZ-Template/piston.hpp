@@ -0,0 +1,20 @@
+#pragma once
+
+#include "api.h"
+
+namespace ez {
+class Piston {
+ public:
+  pros::adi::DigitalOut piston;
+  Piston(int input_port, bool default_state = false);
+  void set(bool input);
+  bool get();
+  void button_toggle(int toggle);
+  void buttons(int active, int deactive);
+
+ private:
+  bool reversed = false;
+  bool current = false;
+  int last_press = 0;
+};
+}  // namespace ez
@@ -0,0 +1,34 @@
+/**
+ * \file api.h
+ *
+ * Host stand-in for the PROS api.h.  Only the parts of PROS this project
+ * uses are here, backed by the simulation in sim/src.
+ */
+
+#ifndef _PROS_API_H_
+#define _PROS_API_H_
+
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#define PROS_VERSION_MAJOR 4
+#define PROS_VERSION_MINOR 1
+#define PROS_VERSION_PATCH 0
+#define PROS_VERSION_STRING "4.1.0-sim"
+
+#include "pros/misc.h"
+#include "pros/motors.h"
+#include "pros/rtos.h"
+
+#include "pros/adi.hpp"
+#include "pros/misc.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/motors.hpp"
+#include "pros/rtos.hpp"
+
+#endif  // _PROS_API_H_
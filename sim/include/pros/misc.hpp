@@ -0,0 +1,59 @@
+/**
+ * \file pros/misc.hpp
+ *
+ * Host stand-in for the PROS controller, competition and SD card functions.
+ * The controller reads whatever sim::controllerSet() last put on it.
+ */
+
+#ifndef _PROS_MISC_HPP_
+#define _PROS_MISC_HPP_
+
+#include <cstdint>
+#include <string>
+
+#include "pros/misc.h"
+
+namespace pros {
+class Controller {
+ public:
+  Controller(controller_id_e_t id);
+
+  std::int32_t get_analog(controller_analog_e_t channel);
+  std::int32_t get_digital(controller_digital_e_t button);
+  std::int32_t get_digital_new_press(controller_digital_e_t button);
+  std::int32_t get_battery_capacity();
+  std::int32_t is_connected();
+  std::int32_t rumble(const char* rumble_pattern);
+  std::int32_t clear();
+  std::int32_t clear_line(std::uint8_t line);
+  std::int32_t set_text(std::uint8_t line, std::uint8_t col, const char* str);
+  std::int32_t set_text(std::uint8_t line, std::uint8_t col, const std::string& str);
+
+  template <typename... Params>
+  std::int32_t print(std::uint8_t line, std::uint8_t col, const char* fmt, Params... args) {
+    return 1;
+  }
+
+ private:
+  controller_id_e_t id;
+  int last_pressed = 0;
+};
+
+namespace battery {
+double get_capacity();
+std::int32_t get_voltage();
+}  // namespace battery
+
+namespace competition {
+std::uint8_t get_status();
+std::uint8_t is_autonomous();
+std::uint8_t is_connected();
+std::uint8_t is_disabled();
+}  // namespace competition
+
+namespace usd {
+std::int32_t is_installed();
+}  // namespace usd
+}  // namespace pros
+
+#endif  // _PROS_MISC_HPP_
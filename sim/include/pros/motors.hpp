@@ -0,0 +1,82 @@
+/**
+ * \file pros/motors.hpp
+ *
+ * Host stand-in for pros::Motor, backed by sim::motorState().
+ */
+
+#ifndef _PROS_MOTORS_HPP_
+#define _PROS_MOTORS_HPP_
+
+#include <cstdint>
+
+#include "pros/motors.h"
+
+namespace pros {
+inline namespace v5 {
+enum class MotorGears {
+  ratio_36_to_1 = 0,
+  red = ratio_36_to_1,
+  rpm_100 = ratio_36_to_1,
+  ratio_18_to_1 = 1,
+  green = ratio_18_to_1,
+  rpm_200 = ratio_18_to_1,
+  ratio_6_to_1 = 2,
+  blue = ratio_6_to_1,
+  rpm_600 = ratio_6_to_1,
+  invalid = INT32_MAX
+};
+
+enum class MotorUnits {
+  degrees = 0,
+  deg = 0,
+  rotations = 1,
+  counts = 2,
+  invalid = INT32_MAX
+};
+
+enum class MotorBrake {
+  coast = 0,
+  brake = 1,
+  hold = 2,
+  invalid = INT32_MAX
+};
+
+class Motor {
+ public:
+  Motor(const std::int8_t port, const MotorGears gearset = MotorGears::invalid, const MotorUnits encoder_units = MotorUnits::invalid);
+
+  std::int32_t move(std::int32_t voltage) const;
+  std::int32_t move_absolute(const double position, const std::int32_t velocity) const;
+  std::int32_t move_relative(const double position, const std::int32_t velocity) const;
+  std::int32_t move_velocity(const std::int32_t velocity) const;
+  std::int32_t move_voltage(const std::int32_t voltage) const;
+  std::int32_t brake() const;
+
+  double get_position(const std::uint8_t index = 0) const;
+  double get_target_position(const std::uint8_t index = 0) const;
+  double get_actual_velocity(const std::uint8_t index = 0) const;
+  std::int32_t get_voltage(const std::uint8_t index = 0) const;
+  std::int32_t get_current_draw(const std::uint8_t index = 0) const;
+  double get_temperature(const std::uint8_t index = 0) const;
+  std::int32_t is_over_current(const std::uint8_t index = 0) const;
+  std::int32_t is_over_temp(const std::uint8_t index = 0) const;
+
+  std::int32_t tare_position(const std::uint8_t index = 0) const;
+  std::int32_t set_zero_position(const double position, const std::uint8_t index = 0) const;
+  std::int32_t set_brake_mode(const motor_brake_mode_e_t mode, const std::uint8_t index = 0) const;
+  std::int32_t set_brake_mode(const MotorBrake mode, const std::uint8_t index = 0) const;
+  motor_brake_mode_e_t get_brake_mode(const std::uint8_t index = 0) const;
+  std::int32_t set_gearing(const MotorGears gearset, const std::uint8_t index = 0) const;
+  MotorGears get_gearing(const std::uint8_t index = 0) const;
+  std::int8_t get_port(const std::uint8_t index = 0) const;
+  std::int32_t set_reversed(const bool reverse, const std::uint8_t index = 0);
+  std::int32_t is_reversed(const std::uint8_t index = 0) const;
+
+ private:
+  std::int8_t port;
+  int direction() const;
+};
+}  // namespace v5
+}  // namespace pros
+
+#endif  // _PROS_MOTORS_HPP_
@@ -0,0 +1,63 @@
+/**
+ * \file pros/rtos.hpp
+ *
+ * Host stand-in for the PROS RTOS.  Tasks are threads that take turns on the
+ * simulated clock, see sim.hpp.
+ */
+
+#ifndef _PROS_RTOS_HPP_
+#define _PROS_RTOS_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "pros/rtos.h"
+#include "sim.hpp"
+
+namespace pros {
+class Task {
+ public:
+  template <class F>
+  Task(F&& function, std::uint32_t prio = TASK_PRIORITY_DEFAULT, std::uint16_t stack_depth = TASK_STACK_DEPTH_DEFAULT, const char* name = "")
+      : task(sim::taskCreate(std::function<void()>(std::forward<F>(function)), prio, name)) {}
+
+  template <class F>
+  Task(F&& function, const char* name)
+      : Task(std::forward<F>(function), TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+  static Task current();
+  static void delay(const std::uint32_t milliseconds);
+  static void delay_until(std::uint32_t* const prev_time, const std::uint32_t delta);
+  static std::uint32_t get_count();
+
+  std::uint32_t get_priority();
+  const char* get_name();
+  void remove();
+
+ private:
+  explicit Task(int task) : task(task) {}
+  int task;
+};
+
+class Mutex {
+ public:
+  bool take();
+  bool take(std::uint32_t timeout);
+  bool give();
+  void lock();
+  void unlock();
+  bool try_lock();
+
+ private:
+  int owner = -1;
+};
+
+using std::uint32_t;
+
+std::uint32_t millis();
+std::uint64_t micros();
+void delay(const std::uint32_t milliseconds);
+}  // namespace pros
+
+#endif  // _PROS_RTOS_HPP_
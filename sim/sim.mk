@@ -0,0 +1,54 @@
+# Host simulation of the robot program.  `make sim` builds bin/sim/robot from
+# src/ against the stand-in PROS and EZ-Template in sim/, so autons can run on
+# a PC, and the tools in sim/tools that run it.  See sim/include/sim.hpp.
+# `make sim-test` builds and runs the tests in sim/tests on the same objects.
+
+SIM_CXX?=g++
+SIMDIR=$(ROOT)/sim
+SIM_BINDIR=$(BINDIR)/sim
+SIM_INCDIR=$(SIM_BINDIR)/include
+SIM_BIN=$(SIM_BINDIR)/robot
+SIM_SRC=$(wildcard $(SRCDIR)/*.cpp) $(wildcard $(SIMDIR)/src/*.cpp)
+SIM_OBJ=$(patsubst $(ROOT)/%.cpp,$(SIM_BINDIR)/%.o,$(SIM_SRC))
+SIM_HEADERS=$(wildcard $(INCDIR)/*.hpp) $(INCDIR)/main.h $(shell find $(SIMDIR)/include -type f)
+SIM_TESTS=$(patsubst $(SIMDIR)/tests/%.cpp,$(SIM_BINDIR)/tests/%,$(wildcard $(SIMDIR)/tests/*.cpp))
+SIM_TEST_OBJ=$(filter-out $(SIM_BINDIR)/sim/src/main.o,$(SIM_OBJ))
+SIM_TOOLS=$(patsubst $(SIMDIR)/tools/%.cpp,$(SIM_BINDIR)/%,$(wildcard $(SIMDIR)/tools/*.cpp))
+SIM_CXXFLAGS=-std=gnu++20 -O2 -g -pthread -MMD -MP $(EXTRA_CXXFLAGS) -I$(SIM_INCDIR) -idirafter $(INCDIR)
+
+.PHONY: sim sim-test
+sim: $(SIM_BIN) $(SIM_TOOLS)
+
+sim-test: $(SIM_TESTS)
+	@for test in $(SIM_TESTS); do $$test || exit 1; done
+
+# Project headers include "api.h" and "pros/..." from their own folder first,
+# so they get copied next to the stand-ins instead of using include/ directly
+$(SIM_INCDIR)/.stamp: $(SIM_HEADERS)
+	@rm -rf $(SIM_INCDIR) && mkdir -p $(SIM_INCDIR)
+	@cp $(wildcard $(INCDIR)/*.hpp) $(INCDIR)/main.h $(SIM_INCDIR)
+	@cp -r $(SIMDIR)/include/. $(SIM_INCDIR)
+	@touch $@
+
+$(SIM_BINDIR)/%.o: $(ROOT)/%.cpp $(SIM_INCDIR)/.stamp
+	@mkdir -p $(dir $@)
+	@echo "Compiling $< for the sim"
+	@$(SIM_CXX) $(SIM_CXXFLAGS) -c $< -o $@
+
+$(SIM_BIN): $(SIM_OBJ)
+	@echo "Linking $@"
+	@$(SIM_CXX) -pthread $^ -o $@
+
+# Tests have their own main() in place of the sim's
+$(SIM_BINDIR)/tests/%: $(SIMDIR)/tests/%.cpp $(wildcard $(SIMDIR)/tests/*.hpp) $(SIM_TEST_OBJ)
+	@mkdir -p $(dir $@)
+	@echo "Compiling $@"
+	@$(SIM_CXX) $(SIM_CXXFLAGS) -DSIM_TESTS_DIR=\"$(SIMDIR)/tests\" $< $(SIM_TEST_OBJ) -o $@
+
+# Tools don't use the robot program, they run bin/sim/robot
+$(SIM_BINDIR)/%: $(SIMDIR)/tools/%.cpp $(wildcard $(SIMDIR)/tools/*.hpp)
+	@mkdir -p $(dir $@)
+	@echo "Compiling $@"
+	@$(SIM_CXX) -std=gnu++20 -O2 -g -pthread $< -o $@
+
+-include $(SIM_OBJ:.o=.d)
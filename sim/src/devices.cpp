@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "api.h"
+#include "sim.hpp"
+
+namespace {
+int gearsetRpm(pros::MotorGears gearset) {
+  switch (gearset) {
+    case pros::MotorGears::red:
+      return 100;
+    case pros::MotorGears::blue:
+      return 600;
+    default:
+      return 200;
+  }
+}
+
+pros::MotorGears gearsetGet(int rpm) {
+  if (rpm == 100) return pros::MotorGears::red;
+  if (rpm == 600) return pros::MotorGears::blue;
+  return pros::MotorGears::green;
+}
+
+int adiPort(std::uint8_t port) {
+  // 'A'-'H', 'a'-'h' and 1-8 all work like they do in PROS
+  if (port >= 'a' && port <= 'h') return port - 'a' + 1;
+  if (port >= 'A' && port <= 'H') return port - 'A' + 1;
+  return port;
+}
+}  // namespace
+
+namespace pros {
+inline namespace v5 {
+/////
+// Motor
+/////
+
+Motor::Motor(const std::int8_t port, const MotorGears gearset, const MotorUnits encoder_units) : port(port) {
+  sim::MotorState& state = sim::motorState(std::abs(port));
+  state.used = true;
+  if (gearset != MotorGears::invalid) state.free_rpm = gearsetRpm(gearset);
+}
+
+int Motor::direction() const { return port < 0 ? -1 : 1; }
+
+std::int32_t Motor::move(std::int32_t voltage) const {
+  voltage = std::clamp(voltage, -127, 127);
+  return move_voltage(voltage * 12000 / 127);
+}
+
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const {
+  sim::MotorState& state = sim::motorState(std::abs(port));
+  state.mode = sim::MOTOR_VOLTAGE;
+  state.command = std::clamp(voltage, -12000, 12000) * direction();
+  return 1;
+}
+
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const {
+  sim::MotorState& state = sim::motorState(std::abs(port));
+  state.mode = sim::MOTOR_VELOCITY;
+  state.command = velocity * direction();
+  return 1;
+}
+
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const {
+  sim::MotorState& state = sim::motorState(std::abs(port));
+  state.mode = sim::MOTOR_POSITION;
+  state.command = position * direction() + state.zero;
+  state.max_velocity = std::abs(velocity);
+  return 1;
+}
+
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const {
+  return move_absolute(get_target_position() + position, velocity);
+}
+
+std::int32_t Motor::brake() const { return move_velocity(0); }
+
+double Motor::get_position(const std::uint8_t index) const {
+  // The encoder counts whole ticks, 1800 a turn on red down to 300 on blue
+  sim::MotorState& state = sim::motorState(std::abs(port));
+  double ticks = 180000.0 / state.free_rpm / 360.0;
+  return (std::floor(state.position * ticks) - std::floor(state.zero * ticks)) / ticks * direction();
+}
+
+double Motor::get_target_position(const std::uint8_t index) const {
+  sim::MotorState& state = sim::motorState(std::abs(port));
+  return state.mode == sim::MOTOR_POSITION ? (state.command - state.zero) * direction() : get_position();
+}
+
+double Motor::get_actual_velocity(const std::uint8_t index) const { return sim::motorState(std::abs(port)).velocity * direction(); }
+
+std::int32_t Motor::get_voltage(const std::uint8_t index) const { return sim::motorState(std::abs(port)).voltage * direction(); }
+
+std::int32_t Motor::get_current_draw(const std::uint8_t index) const { return sim::motorState(std::abs(port)).current; }
+
+double Motor::get_temperature(const std::uint8_t index) const { return 30; }
+
+std::int32_t Motor::is_over_current(const std::uint8_t index) const { return sim::motorState(std::abs(port)).current >= 2500; }
+
+std::int32_t Motor::is_over_temp(const std::uint8_t index) const { return 0; }
+
+std::int32_t Motor::tare_position(const std::uint8_t index) const { return set_zero_position(0); }
+
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t index) const {
+  sim::MotorState& state = sim::motorState(std::abs(port));
+  state.zero = state.position - position * direction();
+  return 1;
+}
+
+std::int32_t Motor::set_brake_mode(const motor_brake_mode_e_t mode, const std::uint8_t index) const {
+  sim::motorState(std::abs(port)).brake = mode;
+  return 1;
+}
+
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+  return set_brake_mode((motor_brake_mode_e_t)mode, index);
+}
+
+motor_brake_mode_e_t Motor::get_brake_mode(const std::uint8_t index) const { return (motor_brake_mode_e_t)sim::motorState(std::abs(port)).brake; }
+
+std::int32_t Motor::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+  sim::motorState(std::abs(port)).free_rpm = gearsetRpm(gearset);
+  return 1;
+}
+
+MotorGears Motor::get_gearing(const std::uint8_t index) const { return gearsetGet(sim::motorState(std::abs(port)).free_rpm); }
+
+std::int8_t Motor::get_port(const std::uint8_t index) const { return port; }
+
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t index) {
+  port = reverse ? -std::abs(port) : std::abs(port);
+  return 1;
+}
+
+std::int32_t Motor::is_reversed(const std::uint8_t index) const { return port < 0; }
+
+/////
+// MotorGroup
+/////
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset, const MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset, const MotorUnits encoder_units) {
+  for (auto port : ports) {
+    motors.push_back(Motor(port, gearset, encoder_units));
+  }
+}
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+  for (auto& motor : motors) motor.move(voltage);
+  return 1;
+}
+
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+  for (auto& motor : motors) motor.move_absolute(position, velocity);
+  return 1;
+}
+
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+  for (auto& motor : motors) motor.move_relative(position, velocity);
+  return 1;
+}
+
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+  for (auto& motor : motors) motor.move_velocity(velocity);
+  return 1;
+}
+
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+  for (auto& motor : motors) motor.move_voltage(voltage);
+  return 1;
+}
+
+std::int32_t MotorGroup::brake() const {
+  for (auto& motor : motors) motor.brake();
+  return 1;
+}
+
+double MotorGroup::get_position(const std::uint8_t index) const { return motors.at(index).get_position(); }
+
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const { return motors.at(index).get_actual_velocity(); }
+
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const { return motors.at(index).get_voltage(); }
+
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const { return motors.at(index).get_current_draw(); }
+
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const { return motors.at(index).is_over_current(); }
+
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const {
+  for (auto& motor : motors) motor.tare_position();
+  return 1;
+}
+
+std::int32_t MotorGroup::set_brake_mode(const motor_brake_mode_e_t mode, const std::uint8_t index) const { return motors.at(index).set_brake_mode(mode); }
+
+std::int32_t MotorGroup::set_brake_mode_all(const motor_brake_mode_e_t mode) const {
+  for (auto& motor : motors) motor.set_brake_mode(mode);
+  return 1;
+}
+
+std::int32_t MotorGroup::size() const { return motors.size(); }
+
+/////
+// ADI
+/////
+
+namespace adi {
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state) : port(adiPort(adi_port)) {
+  sim::adiState(port) = init_state;
+}
+
+std::int32_t DigitalOut::set_value(bool value) {
+  sim::adiState(port) = value;
+  return 1;
+}
+
+DigitalIn::DigitalIn(std::uint8_t adi_port) : port(adiPort(adi_port)) {}
+
+std::int32_t DigitalIn::get_value() const { return sim::adiState(port); }
+
+std::int32_t DigitalIn::get_new_press() {
+  bool value = get_value();
+  bool pressed = value && !last;
+  last = value;
+  return pressed;
+}
+}  // namespace adi
+}  // namespace v5
+
+/////
+// Controller, competition, battery and SD card
+/////
+
+Controller::Controller(controller_id_e_t id) : id(id) {}
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) { return sim::controllerState().analog[channel]; }
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) { return sim::controllerState().digital[button]; }
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+  bool pressed = get_digital(button) && !(last_pressed & (1 << button));
+  last_pressed = get_digital(button) ? last_pressed | (1 << button) : last_pressed & ~(1 << button);
+  return pressed;
+}
+
+std::int32_t Controller::get_battery_capacity() { return 100; }
+
+std::int32_t Controller::is_connected() { return 1; }
+
+std::int32_t Controller::rumble(const char* rumble_pattern) { return 1; }
+
+std::int32_t Controller::clear() { return 1; }
+
+std::int32_t Controller::clear_line(std::uint8_t line) { return 1; }
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const char* str) { return 1; }
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const std::string& str) { return 1; }
+
+namespace battery {
+double get_capacity() { return 100; }
+
+std::int32_t get_voltage() { return 12800; }
+}  // namespace battery
+
+namespace competition {
+// The sim plays a match, so it's always on a field
+std::uint8_t get_status() { return 0; }
+
+std::uint8_t is_autonomous() { return 0; }
+
+std::uint8_t is_connected() { return 1; }
+
+std::uint8_t is_disabled() { return 0; }
+}  // namespace competition
+
+namespace usd {
+// Files would go to /usd on the PC, so there's no SD card
+std::int32_t is_installed() { return 0; }
+}  // namespace usd
+}  // namespace pros
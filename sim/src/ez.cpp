@@ -0,0 +1,738 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "EZ-Template/api.hpp"
+#include "sim.hpp"
+
+pros::Controller master(pros::E_CONTROLLER_MASTER);
+
+namespace ez {
+/////
+// Util
+/////
+
+bool util::AUTON_RAN = true;
+
+int util::sgn(double input) {
+  if (input > 0) return 1;
+  if (input < 0) return -1;
+  return 0;
+}
+
+bool util::reversed_active(double input) { return input < 0; }
+
+double util::clamp(double input, double max, double min) { return std::max(min, std::min(max, input)); }
+
+std::string exit_to_string(exit_output input) {
+  switch (input) {
+    case RUNNING:
+      return "Running";
+    case SMALL_EXIT:
+      return "Small";
+    case BIG_EXIT:
+      return "Big";
+    case VELOCITY_EXIT:
+      return "Velocity";
+    case mA_EXIT:
+      return "mA";
+    case ERROR_NO_CONSTANTS:
+      return "Error: Exit condition constants not set!";
+    default:
+      return "Error: Out of bounds!";
+  }
+}
+
+// The sim has no brain screen
+void ez_template_print() {}
+
+void screen_print(std::string text, int line) {}
+
+/////
+// Auton selector
+/////
+
+Auton::Auton() : Name(""), auton_call(nullptr) {}
+
+Auton::Auton(std::string name, std::function<void()> callback) : Name(name), auton_call(callback) {}
+
+AutonSelector::AutonSelector() : auton_page_current(0), auton_count(0) {}
+
+AutonSelector::AutonSelector(std::vector<Auton> autons) : Autons(autons), auton_page_current(0), auton_count(autons.size()) {}
+
+void AutonSelector::selected_auton_call() {
+  if (auton_count == 0) return;
+  Autons[auton_page_current].auton_call();
+}
+
+void AutonSelector::selected_auton_print() {
+  if (auton_count == 0) return;
+  printf("Page %i\n%s\n", auton_page_current + 1, Autons[auton_page_current].Name.c_str());
+}
+
+void AutonSelector::autons_add(std::vector<Auton> autons) {
+  Autons.insert(Autons.end(), autons.begin(), autons.end());
+  auton_count = Autons.size();
+}
+
+namespace as {
+AutonSelector auton_selector;
+
+void initialize() { auton_selector.selected_auton_print(); }
+
+void shutdown() {}
+
+bool enabled() { return true; }
+
+void page_up() {
+  if (auton_selector.auton_count == 0) return;
+  auton_selector.auton_page_current = (auton_selector.auton_page_current + 1) % auton_selector.auton_count;
+}
+
+void page_down() {
+  if (auton_selector.auton_count == 0) return;
+  auton_selector.auton_page_current = (auton_selector.auton_page_current + auton_selector.auton_count - 1) % auton_selector.auton_count;
+}
+}  // namespace as
+
+/////
+// Piston
+/////
+
+Piston::Piston(int input_port, bool default_state) : piston(input_port, default_state), reversed(default_state) {}
+
+void Piston::set(bool input) {
+  piston.set_value(reversed ? !input : input);
+  current = input;
+}
+
+bool Piston::get() { return current; }
+
+void Piston::button_toggle(int toggle) {
+  if (toggle && !last_press) set(!current);
+  last_press = toggle;
+}
+
+void Piston::buttons(int active, int deactive) {
+  if (active && !current)
+    set(true);
+  else if (deactive && current)
+    set(false);
+}
+
+/////
+// PID
+/////
+
+PID::PID() {}
+
+PID::PID(double p, double i, double d, double start_i, std::string name) {
+  constants_set(p, i, d, start_i);
+  name_set(name);
+}
+
+void PID::constants_set(double p, double i, double d, double p_start_i) { constants = {p, i, d, p_start_i}; }
+
+void PID::exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout) {
+  exit = {p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout};
+}
+
+void PID::target_set(double input) { target = input; }
+
+double PID::target_get() { return target; }
+
+PID::Constants PID::constants_get() { return constants; }
+
+void PID::i_reset_toggle(bool toggle) { reset_i_sgn = toggle; }
+
+bool PID::i_reset_get() { return reset_i_sgn; }
+
+void PID::name_set(std::string p_name) { name = p_name; }
+
+std::string PID::name_get() { return name; }
+
+void PID::variables_reset() {
+  output = 0;
+  target = 0;
+  error = 0;
+  prev_error = 0;
+  integral = 0;
+  derivative = 0;
+  timers_reset();
+}
+
+void PID::timers_reset() {
+  i = 0;
+  j = 0;
+  k = 0;
+  l = 0;
+}
+
+double PID::compute(double current) {
+  error = target - current;
+  cur = current;
+  return raw_compute();
+}
+
+double PID::compute_error(double err, double current) {
+  error = err;
+  cur = current;
+  return raw_compute();
+}
+
+double PID::raw_compute() {
+  // Derivative on the sensor, not the error, so a new target doesn't kick
+  derivative = prev_current - cur;
+
+  if (constants.ki != 0) {
+    if (std::abs(error) < constants.start_i) integral += error;
+    if (util::sgn(error) != util::sgn(prev_error) && reset_i_sgn) integral = 0;
+  }
+
+  output = (error * constants.kp) + (integral * constants.ki) + (derivative * constants.kd);
+
+  prev_current = cur;
+  prev_error = error;
+  return output;
+}
+
+void PID::exit_condition_print(ez::exit_output exit_type) {
+  if (!name.empty() && !sim::config().quiet)
+    printf(" %s PID   %s Exit.\n", name.c_str(), exit_to_string(exit_type).c_str());
+}
+
+ez::exit_output PID::exit_condition(bool print) {
+  if (exit.small_error == 0 && exit.small_exit_time == 0 && exit.big_error == 0 && exit.big_exit_time == 0 && exit.velocity_exit_time == 0 && exit.mA_timeout == 0) {
+    if (print) exit_condition_print(ERROR_NO_CONSTANTS);
+    return ERROR_NO_CONSTANTS;
+  }
+
+  if (exit.small_error != 0) {
+    if (std::abs(error) < exit.small_error) {
+      j += util::DELAY_TIME;
+      i = 0;  // Big exit doesn't matter once small exit is counting
+      if (j > exit.small_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(SMALL_EXIT);
+        return SMALL_EXIT;
+      }
+    } else {
+      j = 0;
+    }
+  }
+
+  if (exit.big_error != 0 && exit.big_exit_time != 0) {
+    if (std::abs(error) < exit.big_error) {
+      i += util::DELAY_TIME;
+      if (i > exit.big_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(BIG_EXIT);
+        return BIG_EXIT;
+      }
+    } else {
+      i = 0;
+    }
+  }
+
+  if (exit.velocity_exit_time != 0) {
+    if (std::abs(derivative) <= velocity_zero_main) {
+      k += util::DELAY_TIME;
+      if (k > exit.velocity_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(VELOCITY_EXIT);
+        return VELOCITY_EXIT;
+      }
+    } else {
+      k = 0;
+    }
+  }
+
+  return RUNNING;
+}
+
+ez::exit_output PID::exit_condition(pros::Motor sensor, bool print) {
+  return exit_condition(std::vector<pros::Motor>{sensor}, print);
+}
+
+ez::exit_output PID::exit_condition(std::vector<pros::Motor> sensor, bool print) {
+  if (exit.mA_timeout != 0) {
+    bool over_current = false;
+    for (auto& motor : sensor) {
+      if (motor.is_over_current()) over_current = true;
+    }
+    if (over_current) {
+      l += util::DELAY_TIME;
+      if (l > exit.mA_timeout) {
+        timers_reset();
+        if (print) exit_condition_print(mA_EXIT);
+        return mA_EXIT;
+      }
+    } else {
+      l = 0;
+    }
+  }
+
+  return exit_condition(print);
+}
+
+/////
+// Drive
+/////
+
+Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_ports, int imu_port, double wheel_diameter, double ticks, double ratio)
+    : wheel_diameter(wheel_diameter), wheel_rpm(ticks) {
+  // EZ reads the cartridge off the motor, the robot's drive is on blue
+  for (auto port : left_motor_ports) left_motors.push_back(pros::Motor(port, pros::MotorGears::blue));
+  for (auto port : right_motor_ports) right_motors.push_back(pros::Motor(port, pros::MotorGears::blue));
+  sim::drivetrainSet(left_motor_ports, right_motor_ports, wheel_diameter, ticks);
+
+  headingPID.name_set("Heading");
+  turnPID.name_set("Turn");
+  leftPID.name_set("Left");
+  rightPID.name_set("Right");
+  swingPID.name_set("Swing");
+}
+
+void Drive::initialize() {
+  drive_sensor_reset();
+  drive_imu_reset();
+  if (started) return;
+  started = true;
+  pros::Task([this]() { ez_auto_task(); }, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "EZ-Template");
+}
+
+void Drive::ez_auto_task() {
+  std::uint32_t next_wake = pros::millis();
+  while (true) {
+    switch (mode) {
+      case DRIVE:
+        drive_pid_task();
+        break;
+      case TURN:
+        turn_pid_task();
+        break;
+      case SWING:
+        swing_pid_task();
+        break;
+      default:
+        break;
+    }
+    pros::Task::delay_until(&next_wake, util::DELAY_TIME);
+  }
+}
+
+int Drive::speed_limit(double traveled) {
+  if (!slew_on || slew_distance <= 0) return max_speed;
+  double ramp = std::min(1.0, std::abs(traveled) / slew_distance);
+  return std::min(max_speed, (int)(slew_min_speed + (max_speed - slew_min_speed) * ramp));
+}
+
+void Drive::drive_pid_task() {
+  leftPID.compute(drive_sensor_left());
+  rightPID.compute(drive_sensor_right());
+  headingPID.compute(drive_imu_get());
+
+  double traveled = ((drive_sensor_left() - l_start) + (drive_sensor_right() - r_start)) / 2.0;
+  int limit = speed_limit(traveled);
+  double l_out = util::clamp(leftPID.output, limit, -limit);
+  double r_out = util::clamp(rightPID.output, limit, -limit);
+  double gyro_out = heading_on ? headingPID.output : 0;
+
+  if (drive_toggle) private_drive_set(l_out + gyro_out, r_out - gyro_out);
+}
+
+void Drive::turn_pid_task() {
+  turnPID.compute(drive_imu_get());
+  double out = util::clamp(turnPID.output, max_speed, -max_speed);
+  if (drive_toggle) private_drive_set(out, -out);
+}
+
+void Drive::swing_pid_task() {
+  swingPID.compute(drive_imu_get());
+  leftPID.compute(drive_sensor_left());
+  rightPID.compute(drive_sensor_right());
+  double out = util::clamp(swingPID.output, max_speed, -max_speed);
+  double opposite = max_speed == 0 ? 0 : out / max_speed * swing_opposite_speed;
+
+  // With no opposite speed the other side holds where it was with the drive PID, like EZ
+  if (!drive_toggle) return;
+  if (current_swing == LEFT_SWING)
+    private_drive_set(out, swing_opposite_speed == 0 ? rightPID.output : opposite);
+  else
+    private_drive_set(swing_opposite_speed == 0 ? leftPID.output : -opposite, -out);
+}
+
+void Drive::private_drive_set(int left, int right) {
+  left = std::clamp(left, -127, 127);
+  right = std::clamp(right, -127, 127);
+  for (auto& motor : left_motors) motor.move(left);
+  for (auto& motor : right_motors) motor.move(right);
+  output_left = left;
+  output_right = right;
+}
+
+void Drive::drive_mode_set(e_mode p_mode) {
+  mode = p_mode;
+  if (mode == DISABLE) private_drive_set(0, 0);
+}
+
+e_mode Drive::drive_mode_get() { return mode; }
+
+void Drive::drive_set(int left, int right) { private_drive_set(left, right); }
+
+std::vector<int> Drive::drive_get() { return {output_left, output_right}; }
+
+void Drive::drive_brake_set(pros::motor_brake_mode_e_t brake_type) {
+  brake = brake_type;
+  for (auto& motor : left_motors) motor.set_brake_mode(brake_type);
+  for (auto& motor : right_motors) motor.set_brake_mode(brake_type);
+}
+
+pros::motor_brake_mode_e_t Drive::drive_brake_get() { return brake; }
+
+/////
+// Sensors
+/////
+
+double Drive::drive_sensor_left() {
+  pros::Motor& motor = left_motors.front();
+  double cartridge = motor.get_gearing() == pros::MotorGears::blue ? 600 : motor.get_gearing() == pros::MotorGears::red ? 100 : 200;
+  return motor.get_position() / 360.0 * (wheel_rpm / cartridge) * wheel_diameter * M_PI;
+}
+
+double Drive::drive_sensor_right() {
+  pros::Motor& motor = right_motors.front();
+  double cartridge = motor.get_gearing() == pros::MotorGears::blue ? 600 : motor.get_gearing() == pros::MotorGears::red ? 100 : 200;
+  return motor.get_position() / 360.0 * (wheel_rpm / cartridge) * wheel_diameter * M_PI;
+}
+
+void Drive::drive_sensor_reset() {
+  for (auto& motor : left_motors) motor.tare_position();
+  for (auto& motor : right_motors) motor.tare_position();
+  l_start = 0;
+  r_start = 0;
+}
+
+// Same as imu.set_rotation(), the scaler gets applied after
+void Drive::drive_imu_reset(double new_heading) { imu_offset = new_heading - sim::imuGet(); }
+
+double Drive::drive_imu_get() { return (sim::imuGet() + imu_offset) * imu_scaler; }
+
+void Drive::drive_imu_scaler_set(double scaler) { imu_scaler = scaler; }
+
+double Drive::drive_imu_scaler_get() { return imu_scaler; }
+
+bool Drive::drive_imu_calibrate(bool run_loading_animation) { return true; }
+
+void Drive::drive_angle_set(okapi::QAngle p_angle) { drive_angle_set(p_angle.convert(okapi::degree)); }
+
+void Drive::drive_angle_set(double angle) {
+  headingPID.target_set(angle);
+  turnPID.target_set(angle);
+  swingPID.target_set(angle);
+  drive_imu_reset(angle);
+}
+
+/////
+// Driver control
+/////
+
+void Drive::opcontrol_arcade_standard(e_type stick_type) {
+  int fwd = master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+  int turn = master.get_analog(stick_type == SPLIT ? pros::E_CONTROLLER_ANALOG_RIGHT_X : pros::E_CONTROLLER_ANALOG_LEFT_X);
+  opcontrol_joystick_threshold_iterate(fwd + turn, fwd - turn);
+}
+
+void Drive::opcontrol_curve_default_set(double left, double right) {}
+
+void Drive::opcontrol_drive_activebrake_set(double kp) {}
+
+void Drive::opcontrol_curve_buttons_toggle(bool toggle) { curve_buttons = toggle; }
+
+bool Drive::opcontrol_curve_buttons_toggle_get() { return curve_buttons; }
+
+void Drive::opcontrol_curve_buttons_left_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase) {}
+
+void Drive::opcontrol_curve_buttons_right_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase) {}
+
+void Drive::opcontrol_curve_buttons_iterate() {}
+
+// Curves are left at 0, which is a straight line
+double Drive::opcontrol_curve_left(double x) { return x; }
+
+double Drive::opcontrol_curve_right(double x) { return x; }
+
+void Drive::opcontrol_joystick_threshold_set(int threshold) { joystick_threshold = threshold; }
+
+void Drive::opcontrol_drive_sensors_reset() {
+  if (util::AUTON_RAN) {
+    drive_sensor_reset();
+    util::AUTON_RAN = false;
+  }
+}
+
+void Drive::opcontrol_joystick_threshold_iterate(int l_stick, int r_stick) {
+  if (std::abs(l_stick) > joystick_threshold || std::abs(r_stick) > joystick_threshold) {
+    drive_mode_set(DISABLE);
+    private_drive_set(l_stick, r_stick);
+  } else {
+    private_drive_set(0, 0);
+  }
+}
+
+/////
+// Autonomous motions
+/////
+
+void Drive::pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading) {
+  pid_drive_set(p_target.convert(okapi::inch), speed, slew_on, toggle_heading);
+}
+
+void Drive::pid_drive_set(double target, int speed, bool p_slew_on, bool toggle_heading) {
+  PID::Constants constants = target >= 0 ? forward_drivePID.constants_get() : backward_drivePID.constants_get();
+  leftPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+  rightPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+
+  l_start = drive_sensor_left();
+  r_start = drive_sensor_right();
+  leftPID.target_set(l_start + target);
+  rightPID.target_set(r_start + target);
+  leftPID.timers_reset();
+  rightPID.timers_reset();
+
+  heading_on = toggle_heading;
+  slew_on = p_slew_on;
+  pid_speed_max_set(speed);
+  drive_mode_set(DRIVE);
+}
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on) { pid_turn_set(p_target.convert(okapi::degree), speed, slew_on); }
+
+void Drive::pid_turn_set(double target, int speed, bool p_slew_on) {
+  headingPID.target_set(target);
+  turnPID.target_set(target);
+  turnPID.timers_reset();
+  slew_on = false;
+  pid_speed_max_set(speed);
+  drive_mode_set(TURN);
+}
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on) { pid_turn_relative_set(p_target.convert(okapi::degree), speed, slew_on); }
+
+void Drive::pid_turn_relative_set(double target, int speed, bool slew_on) { pid_turn_set(headingPID.target_get() + target, speed, slew_on); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
+  pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed, slew_on);
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool p_slew_on) {
+  bool forward = (type == LEFT_SWING) == (target >= drive_imu_get());
+  PID::Constants constants = forward ? forward_swingPID.constants_get() : backward_swingPID.constants_get();
+  swingPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+
+  current_swing = type;
+  swing_opposite_speed = opposite_speed;
+  PID::Constants hold = forward_drivePID.constants_get();
+  leftPID.constants_set(hold.kp, hold.ki, hold.kd, hold.start_i);
+  rightPID.constants_set(hold.kp, hold.ki, hold.kd, hold.start_i);
+  leftPID.target_set(drive_sensor_left());
+  rightPID.target_set(drive_sensor_right());
+  headingPID.target_set(target);
+  swingPID.target_set(target);
+  swingPID.timers_reset();
+  slew_on = false;
+  pid_speed_max_set(speed);
+  drive_mode_set(SWING);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
+  pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
+  pid_swing_set(type, headingPID.target_get() + target, speed, opposite_speed, slew_on);
+}
+
+void Drive::pid_targets_reset() {
+  headingPID.target_set(0);
+  leftPID.target_set(0);
+  rightPID.target_set(0);
+  turnPID.target_set(0);
+  swingPID.target_set(0);
+}
+
+void Drive::wait_print(std::string name, ez::exit_output exit) {
+  if (print_toggle && !sim::config().quiet)
+    printf("  %s: %s Exit, error: %.2f.\n", name.c_str(), exit_to_string(exit).c_str(),
+           name == "Turn" ? turnPID.error : name == "Swing" ? swingPID.error : leftPID.error);
+}
+
+void Drive::pid_wait() {
+  pros::delay(util::DELAY_TIME);
+
+  if (mode == DRIVE) {
+    exit_output left_exit = RUNNING;
+    exit_output right_exit = RUNNING;
+    while (left_exit == RUNNING || right_exit == RUNNING) {
+      left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
+      right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
+      pros::delay(util::DELAY_TIME);
+    }
+    wait_print("Left", left_exit);
+    if (left_exit == mA_EXIT || left_exit == VELOCITY_EXIT || right_exit == mA_EXIT || right_exit == VELOCITY_EXIT) interfered = true;
+  } else if (mode == TURN) {
+    exit_output turn_exit = RUNNING;
+    while (turn_exit == RUNNING) {
+      turn_exit = turnPID.exit_condition({left_motors[0], right_motors[0]});
+      pros::delay(util::DELAY_TIME);
+    }
+    wait_print("Turn", turn_exit);
+    if (turn_exit == mA_EXIT || turn_exit == VELOCITY_EXIT) interfered = true;
+  } else if (mode == SWING) {
+    exit_output swing_exit = RUNNING;
+    pros::Motor& sensor = current_swing == LEFT_SWING ? left_motors[0] : right_motors[0];
+    while (swing_exit == RUNNING) {
+      swing_exit = swingPID.exit_condition(sensor);
+      pros::delay(util::DELAY_TIME);
+    }
+    wait_print("Swing", swing_exit);
+    if (swing_exit == mA_EXIT || swing_exit == VELOCITY_EXIT) interfered = true;
+  }
+}
+
+void Drive::pid_wait_until(okapi::QAngle target) { pid_wait_until(target.convert(okapi::degree)); }
+
+void Drive::pid_wait_until(okapi::QLength target) { pid_wait_until(target.convert(okapi::inch)); }
+
+void Drive::pid_wait_until(double target) {
+  if (mode == DRIVE) {
+    // Target is how far into the motion to wait for
+    int l_sgn = util::sgn(leftPID.target_get() - drive_sensor_left());
+    int r_sgn = util::sgn(rightPID.target_get() - drive_sensor_right());
+    double l_tar = l_start + target;
+    double r_tar = r_start + target;
+    exit_output left_exit = RUNNING;
+    exit_output right_exit = RUNNING;
+    while (util::sgn(l_tar - drive_sensor_left()) == l_sgn || util::sgn(r_tar - drive_sensor_right()) == r_sgn) {
+      left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
+      right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
+      if (left_exit != RUNNING && right_exit != RUNNING) {
+        wait_print("Left", left_exit);
+        if (left_exit == mA_EXIT || left_exit == VELOCITY_EXIT || right_exit == mA_EXIT || right_exit == VELOCITY_EXIT) interfered = true;
+        return;
+      }
+      pros::delay(util::DELAY_TIME);
+    }
+  } else if (mode == TURN || mode == SWING) {
+    PID& pid = mode == TURN ? turnPID : swingPID;
+    int g_sgn = util::sgn(target - drive_imu_get());
+    exit_output exit = RUNNING;
+    while (util::sgn(target - drive_imu_get()) == g_sgn) {
+      exit = mode == TURN ? pid.exit_condition({left_motors[0], right_motors[0]}) : pid.exit_condition(current_swing == LEFT_SWING ? left_motors[0] : right_motors[0]);
+      if (exit != RUNNING) {
+        wait_print(mode == TURN ? "Turn" : "Swing", exit);
+        if (exit == mA_EXIT || exit == VELOCITY_EXIT) interfered = true;
+        return;
+      }
+      pros::delay(util::DELAY_TIME);
+    }
+  }
+}
+
+void Drive::pid_wait_quick() { pid_wait(); }
+
+void Drive::pid_wait_quick_chain() {
+  // Waits until the error is inside the chain constant, then lets the next motion take over
+  double chain = mode == DRIVE ? drive_chain : mode == TURN ? turn_chain : swing_chain;
+  if (mode == DRIVE) {
+    double target = leftPID.target_get() - l_start;
+    pid_wait_until(target - util::sgn(target) * chain);
+  } else if (mode == TURN || mode == SWING) {
+    PID& pid = mode == TURN ? turnPID : swingPID;
+    pid_wait_until(pid.target_get() - util::sgn(pid.target_get() - drive_imu_get()) * chain);
+  }
+}
+
+void Drive::pid_speed_max_set(int speed) { max_speed = std::abs(speed); }
+
+int Drive::pid_speed_max_get() { return max_speed; }
+
+void Drive::pid_drive_toggle(bool toggle) { drive_toggle = toggle; }
+
+bool Drive::pid_drive_toggle_get() { return drive_toggle; }
+
+void Drive::pid_print_toggle(bool toggle) { print_toggle = toggle; }
+
+bool Drive::pid_print_toggle_get() { return print_toggle && !sim::config().quiet; }
+
+/////
+// Constants
+/////
+
+void Drive::pid_drive_constants_set(double p, double i, double d, double p_start_i) {
+  forward_drivePID.constants_set(p, i, d, p_start_i);
+  backward_drivePID.constants_set(p, i, d, p_start_i);
+  leftPID.constants_set(p, i, d, p_start_i);
+  rightPID.constants_set(p, i, d, p_start_i);
+}
+
+void Drive::pid_heading_constants_set(double p, double i, double d, double p_start_i) { headingPID.constants_set(p, i, d, p_start_i); }
+
+void Drive::pid_turn_constants_set(double p, double i, double d, double p_start_i) { turnPID.constants_set(p, i, d, p_start_i); }
+
+void Drive::pid_swing_constants_set(double p, double i, double d, double p_start_i) {
+  forward_swingPID.constants_set(p, i, d, p_start_i);
+  backward_swingPID.constants_set(p, i, d, p_start_i);
+  swingPID.constants_set(p, i, d, p_start_i);
+}
+
+void Drive::pid_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error, okapi::QTime p_big_exit_time, okapi::QLength p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_drive_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::inch), p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::inch), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+void Drive::pid_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_turn_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+void Drive::pid_swing_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_swing_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+void Drive::pid_drive_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  leftPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+  rightPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+}
+
+void Drive::pid_turn_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  turnPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+}
+
+void Drive::pid_swing_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  swingPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+}
+
+void Drive::pid_drive_chain_constant_set(okapi::QLength input) { drive_chain = input.convert(okapi::inch); }
+
+void Drive::pid_turn_chain_constant_set(okapi::QAngle input) { turn_chain = input.convert(okapi::degree); }
+
+void Drive::pid_swing_chain_constant_set(okapi::QAngle input) { swing_chain = input.convert(okapi::degree); }
+
+void Drive::slew_drive_constants_set(okapi::QLength distance, int min_speed) {
+  slew_distance = distance.convert(okapi::inch);
+  slew_min_speed = min_speed;
+}
+
+/////
+// PID tuner
+/////
+
+void Drive::pid_tuner_enable() { pid_tuner_on = true; }
+
+void Drive::pid_tuner_disable() { pid_tuner_on = false; }
+
+void Drive::pid_tuner_toggle() { pid_tuner_on = !pid_tuner_on; }
+
+bool Drive::pid_tuner_enabled() { return pid_tuner_on; }
+
+void Drive::pid_tuner_iterate() {}
+}  // namespace ez
@@ -0,0 +1,207 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "main.h"
+#include "sim.hpp"
+
+/**
+ * Runs one auton the way a match would: initialize(), then autonomous() on
+ * the simulated clock, then prints how long it took and where the robot ended.
+ *
+ * bin/sim/robot [--list] [--quiet] [--csv] [--time ms] [--seed n] [--set name=value]... [--pid name=values]... [--tune motion] [--splines file] [--trace file] [auton]
+ *
+ * auton is a name from the selector or its page number, the first page is the
+ * default.  --time is how long to let it run, 15s or 60s for skills.  --seed
+ * changes the IMU noise.  --set changes anything in sim::Config, see
+ * sim::configSet().  --csv prints the result as
+ * name,finished,seconds,x,y,theta for tools to read.
+ *
+ * --pid changes the chassis' constants after initialize(), ie.
+ * --pid turn=3,0.05,20,15, see sim::tuneSet().  --tune drive, turn or swing
+ * runs sim::tuneRun() instead of an auton and prints the constants it used
+ * and result=settle,overshoot,error,heading,finished.
+ *
+ * --splines writes every spline autonSplines() adds to a file, the same as
+ * /usd/splines.bin on the robot, so the SD card can be loaded ahead of time.
+ *
+ * --trace writes what the drive sensors and IMU read every 10ms of the auton,
+ * with where the robot really was, as left,right,imu,x,y,theta.  The odom
+ * tests in sim/tests/traces replay these.
+ */
+
+namespace {
+void usage() {
+  printf("usage: robot [--list] [--quiet] [--csv] [--time ms] [--seed n] [--set name=value]... [--pid name=values]... [--tune motion] [--splines file] [--trace file] [auton]\n");
+  std::_Exit(2);
+}
+
+// Finds an auton by page number or name, -1 if it isn't there
+int autonFind(std::string auton) {
+  auto& selector = ez::as::auton_selector;
+  char* end = nullptr;
+  long page = strtol(auton.c_str(), &end, 10);
+  if (!auton.empty() && *end == '\0') return page >= 1 && page <= selector.auton_count ? page - 1 : -1;
+  for (int i = 0; i < selector.auton_count; i++) {
+    if (selector.Autons[i].Name.substr(0, selector.Autons[i].Name.find('\n')) == auton) return i;
+  }
+  return -1;
+}
+
+// Sets a config value from name=value
+void configSet(std::string setting) {
+  std::size_t equals = setting.find('=');
+  if (equals == std::string::npos || !sim::configSet(setting.substr(0, equals), atof(setting.c_str() + equals + 1))) {
+    printf("sim: can't set %s\n", setting.c_str());
+    std::_Exit(2);
+  }
+}
+
+// Sets chassis constants from name=values, after initialize()
+void pidSet(std::string setting) {
+  std::size_t equals = setting.find('=');
+  std::vector<double> values;
+  for (std::size_t i = equals; i != std::string::npos; i = setting.find(',', i + 1)) {
+    values.push_back(atof(setting.c_str() + i + 1));
+  }
+  if (equals == std::string::npos || !sim::tuneSet(setting.substr(0, equals), values)) {
+    printf("sim: can't set %s\n", setting.c_str());
+    std::_Exit(2);
+  }
+}
+
+std::string autonName(int page) {
+  std::string name = ez::as::auton_selector.Autons[page].Name;
+  return name.substr(0, name.find('\n'));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool list = false;
+  bool csv = false;
+  int time = 0;
+  std::string auton;
+  std::string tune;
+  std::vector<std::string> pids;
+  std::string splines;
+  std::string trace;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--list"))
+      list = true;
+    else if (!strcmp(argv[i], "--quiet"))
+      sim::config().quiet = true;
+    else if (!strcmp(argv[i], "--time") && i + 1 < argc)
+      time = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+      sim::config().seed = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--csv"))
+      csv = true;
+    else if (!strcmp(argv[i], "--set") && i + 1 < argc)
+      configSet(argv[++i]);
+    else if (!strcmp(argv[i], "--pid") && i + 1 < argc)
+      pids.push_back(argv[++i]);
+    else if (!strcmp(argv[i], "--tune") && i + 1 < argc)
+      tune = argv[++i];
+    else if (!strcmp(argv[i], "--splines") && i + 1 < argc)
+      splines = argv[++i];
+    else if (!strcmp(argv[i], "--trace") && i + 1 < argc)
+      trace = argv[++i];
+    else if (argv[i][0] == '-')
+      usage();
+    else
+      auton = argv[i];
+  }
+
+  // Quiet runs only print the result, everything the robot prints goes away
+  FILE* out = stdout;
+  if (sim::config().quiet) {
+    out = fdopen(dup(fileno(stdout)), "w");
+    if (!freopen("/dev/null", "w", stdout)) out = stderr;
+  }
+
+  sim::poseSet(sim::config().start);
+  int init = sim::taskCreate(initialize, TASK_PRIORITY_DEFAULT, "initialize");
+  if (!sim::runUntil([init]() { return sim::taskDone(init); }, 10000)) {
+    fprintf(out, "sim: initialize() didn't finish\n");
+    fflush(nullptr);
+    std::_Exit(1);
+  }
+
+  for (auto& pid : pids) pidSet(pid);
+
+  if (!splines.empty()) {
+    bool written = splinesWrite(splines.c_str());
+    fprintf(out, written ? "sim: wrote splines to %s\n" : "sim: couldn't write %s\n", splines.c_str());
+    fflush(nullptr);
+    std::_Exit(written ? 0 : 1);
+  }
+
+  if (!tune.empty()) {
+    if (tune != "drive" && tune != "turn" && tune != "swing") usage();
+    sim::TuneResult result;
+    int tune_task = sim::taskCreate([&result, tune]() { result = sim::tuneRun(tune); }, TASK_PRIORITY_DEFAULT, "tune");
+    bool finished = sim::runUntil([tune_task]() { return sim::taskDone(tune_task); }, time > 0 ? time : 60000);
+    fprintf(out, "%sresult=%.3f,%.3f,%.3f,%.3f,%i\n", sim::tuneGet().c_str(), result.settle, result.overshoot, result.error, result.heading, finished);
+    fflush(nullptr);
+    std::_Exit(finished ? 0 : 1);
+  }
+
+  if (list) {
+    for (int i = 0; i < ez::as::auton_selector.auton_count; i++) {
+      fprintf(out, "%i: %s\n", i + 1, autonName(i).c_str());
+    }
+    fflush(nullptr);
+    std::_Exit(0);
+  }
+
+  int page = auton.empty() ? 0 : autonFind(auton);
+  if (page < 0) {
+    fprintf(out, "sim: no auton called %s, try --list\n", auton.c_str());
+    fflush(nullptr);
+    std::_Exit(2);
+  }
+  ez::as::auton_selector.auton_page_current = page;
+  std::string name = autonName(page);
+  if (time <= 0) time = name.find("SKILLS") != std::string::npos ? 60000 : 15000;
+
+  if (!trace.empty()) {
+    FILE* file = fopen(trace.c_str(), "w");
+    if (!file) {
+      fprintf(out, "sim: couldn't write %s\n", trace.c_str());
+      fflush(nullptr);
+      std::_Exit(1);
+    }
+    fprintf(file, "left,right,imu,x,y,theta\n");
+    // Above the odom job, so each row is what it's about to read
+    sim::taskCreate(
+        [file]() {
+          while (true) {
+            sim::Pose real = sim::poseGet();
+            fprintf(file, "%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n", chassis.drive_sensor_left(), chassis.drive_sensor_right(), chassis.drive_imu_get(), real.x, real.y, real.theta);
+            pros::delay(ez::util::DELAY_TIME);
+          }
+        },
+        TASK_PRIORITY_MAX, "trace");
+  }
+
+  std::uint64_t start = sim::timeGet();
+  int auto_task = sim::taskCreate(autonomous, TASK_PRIORITY_DEFAULT, "autonomous");
+  bool finished = sim::runUntil([auto_task]() { return sim::taskDone(auto_task); }, time);
+  double elapsed = (sim::timeGet() - start) / 1e6;
+
+  sim::Pose pose = sim::poseGet();
+  if (csv) {
+    fprintf(out, "%s,%i,%.3f,%.3f,%.3f,%.3f\n", name.c_str(), finished, elapsed, pose.x, pose.y, pose.theta);
+  } else {
+    Pose odom = odomGet();
+    fprintf(out, "sim: %s %s in %.2fs, ended at x %.2fin y %.2fin theta %.2fdeg\n", name.c_str(), finished ? "finished" : "timed out", elapsed, pose.x, pose.y, pose.theta);
+    fprintf(out, "sim: odometry thinks x %.2fin y %.2fin theta %.2fdeg\n", odom.x, odom.y, odom.theta);
+  }
+
+  // Tasks never return on their own, so leave without joining them
+  fflush(nullptr);
+  std::_Exit(finished ? 0 : 1);
+}
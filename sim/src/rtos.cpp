@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "pros/rtos.hpp"
+#include "sim.hpp"
+
+namespace {
+struct SimTask {
+  int id;
+  std::string name;
+  std::uint32_t priority;
+  std::function<void()> function;
+  std::uint64_t wake = 0;
+  bool done = false;
+  std::condition_variable turn;
+};
+
+// Only one task holds the turn at a time, running is nullptr while the
+// scheduler in main() has it
+std::mutex schedulerLock;
+std::condition_variable schedulerTurn;
+SimTask* running = nullptr;
+thread_local SimTask* self = nullptr;
+std::uint64_t now = 0;
+
+std::vector<std::unique_ptr<SimTask>>& tasks() {
+  // Function static so tasks can be made during static init
+  static std::vector<std::unique_ptr<SimTask>> all;
+  return all;
+}
+
+SimTask* taskGet(int task) {
+  if (task < 1 || task > (int)tasks().size()) return nullptr;
+  return tasks()[task - 1].get();
+}
+
+void taskBody(SimTask* task) {
+  self = task;
+  {
+    std::unique_lock<std::mutex> lock(schedulerLock);
+    task->turn.wait(lock, [task]() { return running == task; });
+  }
+  task->function();
+  std::unique_lock<std::mutex> lock(schedulerLock);
+  task->done = true;
+  running = nullptr;
+  schedulerTurn.notify_one();
+}
+
+// Highest priority task that's awake, ties go to whoever has waited longest
+SimTask* taskNext() {
+  SimTask* next = nullptr;
+  for (auto& task : tasks()) {
+    if (task->done || task->wake > now) continue;
+    if (!next || task->priority > next->priority || (task->priority == next->priority && task->wake < next->wake))
+      next = task.get();
+  }
+  return next;
+}
+}  // namespace
+
+namespace sim {
+std::uint64_t timeGet() { return now; }
+
+int taskCreate(std::function<void()> function, std::uint32_t priority, const char* name) {
+  std::unique_lock<std::mutex> lock(schedulerLock);
+  int id = tasks().size() + 1;
+  tasks().push_back(std::unique_ptr<SimTask>(new SimTask{id, name ? name : "", priority, function, now}));
+  std::thread(taskBody, tasks().back().get()).detach();
+  return id;
+}
+
+int taskCurrent() { return self ? self->id : 0; }
+
+bool taskDone(int task) {
+  std::unique_lock<std::mutex> lock(schedulerLock);
+  SimTask* ptr = taskGet(task);
+  return !ptr || ptr->done;
+}
+
+void taskRemove(int task) {
+  std::unique_lock<std::mutex> lock(schedulerLock);
+  SimTask* ptr = taskGet(task);
+  if (ptr) ptr->done = true;
+}
+
+const char* taskName(int task) {
+  SimTask* ptr = taskGet(task);
+  return ptr ? ptr->name.c_str() : "main";
+}
+
+std::uint32_t taskPriority(int task) {
+  SimTask* ptr = taskGet(task);
+  return ptr ? ptr->priority : TASK_PRIORITY_DEFAULT;
+}
+
+void sleepUntil(std::uint64_t wake) {
+  if (!self) {
+    // Called from main(), run everything else until then
+    runUntil(nullptr, wake > now ? (wake - now + 999) / 1000 : 0);
+    return;
+  }
+  std::unique_lock<std::mutex> lock(schedulerLock);
+  self->wake = std::max(wake, now);
+  running = nullptr;
+  schedulerTurn.notify_one();
+  self->turn.wait(lock, []() { return running == self; });
+  // A removed task never gets the turn back, so this only returns to live tasks
+}
+
+bool runUntil(std::function<bool()> done, std::uint32_t timeout) {
+  std::uint64_t end = now + (std::uint64_t)timeout * 1000;
+  while (true) {
+    if (done && done()) return true;
+
+    std::unique_lock<std::mutex> lock(schedulerLock);
+    SimTask* next = taskNext();
+    if (next) {
+      running = next;
+      next->turn.notify_one();
+      schedulerTurn.wait(lock, []() { return running == nullptr; });
+      continue;
+    }
+    if (now >= end) return false;
+
+    // Nobody's awake, move the world up to the next wake
+    std::uint64_t wake = end;
+    for (auto& task : tasks()) {
+      if (!task->done) wake = std::min(wake, task->wake);
+    }
+    lock.unlock();
+    while (now < wake) {
+      worldStep(0.001);
+      now += 1000;
+    }
+  }
+}
+}  // namespace sim
+
+namespace pros {
+Task Task::current() { return Task(sim::taskCurrent()); }
+
+void Task::delay(const std::uint32_t milliseconds) { pros::delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+  *prev_time += delta;
+  sim::sleepUntil((std::uint64_t)*prev_time * 1000);
+}
+
+std::uint32_t Task::get_count() { return 0; }
+
+std::uint32_t Task::get_priority() { return sim::taskPriority(task); }
+
+const char* Task::get_name() { return sim::taskName(task); }
+
+void Task::remove() { sim::taskRemove(task); }
+
+bool Mutex::take() { return take(TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) {
+  int me = sim::taskCurrent();
+  if (owner == me) {
+    // On the brain this task would wait on itself forever
+    printf("sim: %s took a mutex it already holds\n", sim::taskName(me));
+    abort();
+  }
+  std::uint32_t start = millis();
+  // Tasks only switch on a delay, so nothing else can grab it between the check and the take
+  while (owner != -1) {
+    if (timeout != TIMEOUT_MAX && millis() - start >= timeout) return false;
+    delay(1);
+  }
+  owner = me;
+  return true;
+}
+
+bool Mutex::give() {
+  if (owner == -1) return false;
+  owner = -1;
+  return true;
+}
+
+void Mutex::lock() { take(); }
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+std::uint32_t millis() { return sim::timeGet() / 1000; }
+
+std::uint64_t micros() { return sim::timeGet(); }
+
+void delay(const std::uint32_t milliseconds) { sim::sleepUntil(sim::timeGet() + (std::uint64_t)milliseconds * 1000); }
+}  // namespace pros
@@ -0,0 +1,140 @@
+#include <cmath>
+#include <cstdio>
+
+#include "main.h"
+#include "sim.hpp"
+
+// Speeds the autons use
+static const int DRIVE_SPEED = 110;
+static const int TURN_SPEED = 90;
+static const int SWING_SPEED = 90;
+
+namespace sim {
+
+namespace {
+// What the motion being measured has done so far
+struct Motion {
+  bool drive = false;
+  double start = 0;
+  double target = 0;
+  double heading_start = 0;
+  double overshoot = 0;
+  double heading = 0;
+};
+
+double progress(Motion& motion) {
+  if (motion.drive) return (chassis.drive_sensor_left() + chassis.drive_sensor_right()) / 2.0 - motion.start;
+  return chassis.drive_imu_get() - motion.start;
+}
+
+std::string constants(std::string name, ez::PID::Constants constants) {
+  char line[128];
+  snprintf(line, sizeof(line), "%s=%g,%g,%g,%g\n", name.c_str(), constants.kp, constants.ki, constants.kd, constants.start_i);
+  return line;
+}
+
+std::string exits(std::string name, ez::PID::exit_condition_ exit) {
+  char line[128];
+  snprintf(line, sizeof(line), "%s=%i,%g,%i,%g,%i,%i\n", name.c_str(), exit.small_exit_time, exit.small_error, exit.big_exit_time, exit.big_error, exit.velocity_exit_time, exit.mA_timeout);
+  return line;
+}
+}  // namespace
+
+bool tuneSet(std::string name, std::vector<double> v) {
+  if (name.size() > 5 && name.substr(name.size() - 5) == "_exit") {
+    if (v.size() != 6) return false;
+    name = name.substr(0, name.size() - 5);
+    if (name == "drive")
+      chassis.pid_drive_exit_condition_set(v[0], v[1], v[2], v[3], v[4], v[5]);
+    else if (name == "turn")
+      chassis.pid_turn_exit_condition_set(v[0], v[1], v[2], v[3], v[4], v[5]);
+    else if (name == "swing")
+      chassis.pid_swing_exit_condition_set(v[0], v[1], v[2], v[3], v[4], v[5]);
+    else
+      return false;
+    return true;
+  }
+
+  if (v.size() < 1 || v.size() > 4) return false;
+  v.resize(4, 0.0);
+  if (name == "drive")
+    chassis.pid_drive_constants_set(v[0], v[1], v[2], v[3]);
+  else if (name == "heading")
+    chassis.pid_heading_constants_set(v[0], v[1], v[2], v[3]);
+  else if (name == "turn")
+    chassis.pid_turn_constants_set(v[0], v[1], v[2], v[3]);
+  else if (name == "swing")
+    chassis.pid_swing_constants_set(v[0], v[1], v[2], v[3]);
+  else
+    return false;
+  return true;
+}
+
+std::string tuneGet() {
+  return constants("heading", chassis.headingPID.constants) +
+         constants("drive", chassis.forward_drivePID.constants) +
+         constants("turn", chassis.turnPID.constants) +
+         constants("swing", chassis.swingPID.constants) +
+         exits("drive_exit", chassis.leftPID.exit) +
+         exits("turn_exit", chassis.turnPID.exit) +
+         exits("swing_exit", chassis.swingPID.exit);
+}
+
+TuneResult tuneRun(std::string kind) {
+  TuneResult result;
+  Motion motion;
+
+  // Same start as autonomous()
+  chassis.pid_targets_reset();
+  odomImuReset();
+  odomSensorsReset();
+  chassis.drive_brake_set(pros::E_MOTOR_BRAKE_HOLD);
+
+  // Watches every motion from the side while pid_wait() decides when it's done
+  pros::Task watch([&motion]() {
+    while (true) {
+      double over = (progress(motion) - motion.target) * ez::util::sgn(motion.target);
+      motion.overshoot = std::max(motion.overshoot, over);
+      if (motion.drive) motion.heading = std::max(motion.heading, std::abs(chassis.drive_imu_get() - motion.heading_start));
+      pros::delay(ez::util::DELAY_TIME);
+    }
+  });
+
+  // Short and long moves both ways, each starting where the last one stopped
+  std::vector<double> targets;
+  if (kind == "drive")
+    targets = {24, -24, 6, -6, 48, -48, 12, -12};
+  else if (kind == "turn")
+    targets = {90, -90, 45, -45, 180, -180, 15, -15};
+  else
+    targets = {90, -90, 45, -45, -90, 90, -45, 45};
+
+  for (std::size_t i = 0; i < targets.size(); i++) {
+    double target = targets[i];
+    motion = Motion();
+    motion.drive = kind == "drive";
+    // Turns and swings are relative to the last target, not where the robot stopped
+    motion.start = motion.drive ? (chassis.drive_sensor_left() + chassis.drive_sensor_right()) / 2.0 : chassis.headingPID.target_get();
+    motion.heading_start = chassis.headingPID.target_get();
+    motion.target = target;
+
+    int start = pros::millis();
+    if (kind == "drive")
+      chassis.pid_drive_set(target, DRIVE_SPEED);
+    else if (kind == "turn")
+      chassis.pid_turn_relative_set(target, TURN_SPEED);
+    else
+      chassis.pid_swing_relative_set(i < 4 ? ez::LEFT_SWING : ez::RIGHT_SWING, target, SWING_SPEED);
+    chassis.pid_wait();
+
+    result.settle += (pros::millis() - start) / 1000.0;
+    result.overshoot = std::max(result.overshoot, motion.overshoot);
+    result.error = std::max(result.error, std::abs(target - progress(motion)));
+    result.heading = std::max(result.heading, motion.heading);
+  }
+
+  watch.remove();
+  return result;
+}
+
+}  // namespace sim
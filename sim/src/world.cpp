@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+#include "sim.hpp"
+
+namespace {
+const int MOTOR_PORTS = 21;
+const int ADI_PORTS = 8;
+
+struct World {
+  sim::MotorState motors[MOTOR_PORTS + 1];
+  bool adi[ADI_PORTS + 1] = {};
+  sim::ControllerState controller;
+
+  std::vector<int> left_ports;
+  std::vector<int> right_ports;
+  double wheel_diameter = 4;
+  double wheel_rpm = 200;
+
+  sim::Pose pose;
+  double imu = 0;  // Everything the robot has turned since it started, in degrees
+};
+
+World& world() {
+  // Function static so the chassis and motors can use it during static init
+  static World world;
+  return world;
+}
+
+const double GRAVITY = 9.81;
+const double METERS_PER_INCH = 0.0254;
+const int SUBSTEPS = 4;  // Wheel contact is stiff, so the drive steps at 0.25ms
+
+// V5 motor internals.  The current limit is what sets stall torque, and it
+// kicks in below half speed, so the curve is flat torque then a straight line
+// down to free speed
+const double MOTOR_RESISTANCE = 2.4;      // Ohms
+const double MOTOR_CURRENT_LIMIT = 2.5;   // Amps
+const double BRAIN_CURRENT_LIMIT = 20;    // Amps, shared out once there's more than 8 motors
+const double BATTERY_RESISTANCE = 0.1;    // Ohms, the battery sags this much per amp
+
+struct Drivetrain {
+  double wheel[2] = {0, 0};  // Wheel speed in rad/s, left and right
+  double speed = 0;          // Robot speed forward in m/s
+  double turn = 0;           // Robot turn rate in rad/s, clockwise positive
+};
+
+Drivetrain drivetrain;
+std::mt19937 noise;
+double imuReading = 0;
+double imuBias = 0;
+std::uint64_t imuSample = 0;
+double totalCurrent = 0;
+double currentLimit = MOTOR_CURRENT_LIMIT;
+
+// Torque per amp and volts per rad/s at the output of a cartridge
+double motorKt(int free_rpm) { return 2.1 * 100.0 / free_rpm / MOTOR_CURRENT_LIMIT; }
+double motorKv(int free_rpm) { return 12.0 / (free_rpm * 2 * M_PI / 60.0); }
+
+// What the motor can actually put out after the battery sags
+double voltageAvailable() { return std::min(12.0, sim::config().battery - totalCurrent * BATTERY_RESISTANCE); }
+
+// Gets the voltage a motor's own controller would send for a mode, in mV
+double motorVoltage(sim::MotorState& motor) {
+  double volts_per_rpm = 12000.0 / motor.free_rpm;
+  switch (motor.mode) {
+    case sim::MOTOR_VELOCITY:
+      motor.holding = false;
+      return motor.command * volts_per_rpm + (motor.command - motor.velocity) * volts_per_rpm * 2;
+    case sim::MOTOR_POSITION: {
+      motor.holding = false;
+      double error = motor.command - motor.position;
+      double velocity = std::clamp(error * 2.0, -motor.max_velocity, motor.max_velocity);
+      return velocity * volts_per_rpm + (velocity - motor.velocity) * volts_per_rpm * 2;
+    }
+    default:
+      if (motor.command != 0 || motor.brake != 2) {
+        motor.holding = false;
+        return motor.command;
+      }
+      // Hold keeps the motor where it was when it got 0
+      if (!motor.holding) motor.hold_position = motor.position;
+      motor.holding = true;
+      return (motor.hold_position - motor.position) * 100 - motor.velocity * volts_per_rpm;
+  }
+}
+
+// Torque out of a motor in Nm, and sets its current
+double motorTorque(sim::MotorState& motor, double velocity) {
+  motor.voltage = std::clamp(motorVoltage(motor), -voltageAvailable() * 1000, voltageAvailable() * 1000);
+
+  // Coast lets go of the motor at 0, brake shorts it, which fights the motion
+  if (motor.mode == sim::MOTOR_VOLTAGE && motor.voltage == 0 && motor.brake == 0) {
+    motor.current = 0;
+    return 0;
+  }
+  double current = (motor.voltage / 1000.0 - motorKv(motor.free_rpm) * velocity) / MOTOR_RESISTANCE;
+  current = std::clamp(current, -currentLimit, currentLimit);
+  motor.current = std::abs(current) * 1000;
+  return current * motorKt(motor.free_rpm);
+}
+
+// Mechanisms are a lag toward the speed the voltage asks for
+void mechanismStep(sim::MotorState& motor, double dt) {
+  motor.voltage = std::clamp(motorVoltage(motor), -voltageAvailable() * 1000, voltageAvailable() * 1000);
+
+  double target = motor.voltage / 12000.0 * motor.free_rpm;
+  double time_constant = sim::config().motor_time_constant;
+  // Brake and hold short the motor when there's no voltage, so it stops a lot faster
+  if (motor.mode == sim::MOTOR_VOLTAGE && motor.voltage == 0 && motor.brake != 0) time_constant /= 4;
+
+  motor.velocity += (target - motor.velocity) * std::min(1.0, dt / time_constant);
+  motor.position += motor.velocity * 6 * dt;  // rpm to degrees per second
+  motor.current = std::abs(target - motor.velocity) / motor.free_rpm * 2500;
+}
+
+bool isDrivePort(int port) {
+  for (int drive : world().left_ports) {
+    if (std::abs(drive) == port) return true;
+  }
+  for (int drive : world().right_ports) {
+    if (std::abs(drive) == port) return true;
+  }
+  return false;
+}
+
+// Torque one side's motors put on its wheels, in Nm
+double sideTorque(const std::vector<int>& ports, double wheel) {
+  double torque = 0;
+  for (int port : ports) {
+    sim::MotorState& motor = world().motors[std::abs(port)];
+    int direction = port < 0 ? -1 : 1;
+    double ratio = motor.free_rpm / world().wheel_rpm;  // Motor turns per wheel turn
+    torque += motorTorque(motor, wheel * ratio * direction) * ratio * direction;
+  }
+  return torque;
+}
+
+// Sets the motor encoders and velocities from the wheel
+void sideMotorsSet(const std::vector<int>& ports, double wheel, double dt) {
+  for (int port : ports) {
+    sim::MotorState& motor = world().motors[std::abs(port)];
+    int direction = port < 0 ? -1 : 1;
+    double ratio = motor.free_rpm / world().wheel_rpm;
+    motor.velocity = wheel * ratio * direction * 60 / (2 * M_PI);
+    motor.position += motor.velocity * 6 * dt;
+  }
+}
+
+// Smooth sign, friction doesn't flip back and forth around 0
+double smoothSign(double value, double width) { return std::tanh(value / width); }
+
+/**
+ * Steps the drive.  Each side's wheels get torque from the motors and push
+ * on the tiles through friction, so a hard enough start slips the wheels
+ * and the encoders read more than the robot moved.  Turning drags the wheels
+ * sideways, that's the scrub.
+ */
+void drivetrainStep(double dt) {
+  const sim::Config& config = sim::config();
+  World& w = world();
+  double radius = w.wheel_diameter / 2.0 * METERS_PER_INCH;
+  double half_track = config.track_width / 2.0 * METERS_PER_INCH;
+  double normal = config.mass * GRAVITY / 2.0;  // Each side holds half the robot
+
+  double torque[2] = {sideTorque(w.left_ports, drivetrain.wheel[0]), sideTorque(w.right_ports, drivetrain.wheel[1])};
+  double ground[2] = {drivetrain.speed + drivetrain.turn * half_track, drivetrain.speed - drivetrain.turn * half_track};
+
+  double force[2];
+  for (int side = 0; side < 2; side++) {
+    // Friction from the wheel sliding on the tile, tanh keeps it smooth through 0 slip
+    double slip = drivetrain.wheel[side] * radius - ground[side];
+    force[side] = config.wheel_friction * normal * smoothSign(slip, 0.05);
+    double wheel_accel = (torque[side] - force[side] * radius) / config.wheel_inertia;
+    drivetrain.wheel[side] += wheel_accel * dt;
+  }
+
+  double rolling = config.rolling_resistance * config.mass * GRAVITY * smoothSign(drivetrain.speed, 0.01);
+  double scrub = config.scrub * config.mass * GRAVITY * config.scrub_arm * METERS_PER_INCH * smoothSign(drivetrain.turn, 0.05);
+  drivetrain.speed += (force[0] + force[1] - rolling) / config.mass * dt;
+  drivetrain.turn += ((force[0] - force[1]) * half_track - scrub) / config.moment_of_inertia * dt;
+
+  sideMotorsSet(w.left_ports, drivetrain.wheel[0], dt);
+  sideMotorsSet(w.right_ports, drivetrain.wheel[1], dt);
+
+  double turn = drivetrain.turn * 180.0 / M_PI;
+  double speed = drivetrain.speed / METERS_PER_INCH;
+  double heading = (w.pose.theta + turn * dt / 2.0) * M_PI / 180.0;
+  w.pose.x += speed * std::sin(heading) * dt;
+  w.pose.y += speed * std::cos(heading) * dt;
+  w.pose.theta += turn * dt;
+  w.imu += turn * dt;
+}
+
+// The IMU updates every 10ms with a bit of noise and a slowly wandering bias
+void imuStep() {
+  const sim::Config& config = sim::config();
+  std::uint64_t sample = sim::timeGet() / 10000;
+  if (sample == imuSample) return;
+  imuSample = sample;
+
+  std::normal_distribution<double> gaussian(0, 1);
+  imuBias += config.imu_drift * 0.01 + config.imu_bias_walk * 0.1 * gaussian(noise);
+  imuReading = (world().imu + imuBias) / config.imu_scale + config.imu_noise * gaussian(noise);
+}
+}  // namespace
+
+namespace sim {
+Config& config() {
+  static Config config;
+  return config;
+}
+
+bool configSet(std::string name, double value) {
+  Config& c = config();
+  std::pair<const char*, double*> values[] = {
+      {"track_width", &c.track_width},
+      {"mass", &c.mass},
+      {"moment_of_inertia", &c.moment_of_inertia},
+      {"wheel_inertia", &c.wheel_inertia},
+      {"wheel_friction", &c.wheel_friction},
+      {"rolling_resistance", &c.rolling_resistance},
+      {"scrub", &c.scrub},
+      {"scrub_arm", &c.scrub_arm},
+      {"battery", &c.battery},
+      {"imu_scale", &c.imu_scale},
+      {"imu_noise", &c.imu_noise},
+      {"imu_drift", &c.imu_drift},
+      {"imu_bias_walk", &c.imu_bias_walk},
+      {"motor_time_constant", &c.motor_time_constant},
+      {"start_x", &c.start.x},
+      {"start_y", &c.start.y},
+      {"start_theta", &c.start.theta},
+  };
+  for (auto& entry : values) {
+    if (name != entry.first) continue;
+    *entry.second = value;
+    return true;
+  }
+  return false;
+}
+
+MotorState& motorState(int port) { return world().motors[std::clamp(port, 1, MOTOR_PORTS)]; }
+
+bool& adiState(int port) { return world().adi[std::clamp(port, 1, ADI_PORTS)]; }
+
+ControllerState& controllerState() { return world().controller; }
+
+void drivetrainSet(std::vector<int> left_ports, std::vector<int> right_ports, double wheel_diameter, double wheel_rpm) {
+  world().left_ports = left_ports;
+  world().right_ports = right_ports;
+  world().wheel_diameter = wheel_diameter;
+  world().wheel_rpm = wheel_rpm;
+}
+
+Pose poseGet() { return world().pose; }
+
+void poseSet(Pose pose) { world().pose = pose; }
+
+double imuGet() { return imuReading; }
+
+void worldStep(double dt) {
+  World& w = world();
+  static bool seeded = false;
+  if (!seeded) noise.seed(config().seed);
+  seeded = true;
+
+  int used = 0;
+  for (int port = 1; port <= MOTOR_PORTS; port++) {
+    if (w.motors[port].used) used++;
+  }
+  currentLimit = std::min(MOTOR_CURRENT_LIMIT, BRAIN_CURRENT_LIMIT / std::max(used, 1));
+
+  double current = 0;
+  for (int port = 1; port <= MOTOR_PORTS; port++) {
+    if (w.motors[port].used && !isDrivePort(port)) mechanismStep(w.motors[port], dt);
+  }
+  for (int i = 0; i < SUBSTEPS; i++) {
+    drivetrainStep(dt / SUBSTEPS);
+  }
+  for (int port = 1; port <= MOTOR_PORTS; port++) {
+    if (w.motors[port].used) current += w.motors[port].current / 1000.0;
+  }
+  totalCurrent = current;
+  imuStep();
+}
+}  // namespace sim
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Bare bones checks for the sim tests.  A failed CHECK prints where it was
+ * and carries on, checkExit() ends the test with the number of failures.
+ */
+
+inline int checkFailures = 0;
+
+#define CHECK(condition)                                                  \
+  do {                                                                    \
+    if (!(condition)) {                                                   \
+      printf("%s:%i: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      checkFailures++;                                                    \
+    }                                                                     \
+  } while (0)
+
+// Sim tasks are threads that never finish, so leave without joining them
+[[noreturn]] inline void checkExit(const char* name) {
+  printf("%s: %s\n", name, checkFailures ? "FAILED" : "passed");
+  fflush(nullptr);
+  std::_Exit(checkFailures ? 1 : 0);
+}
@@ -0,0 +1,56 @@
+#include "check.hpp"
+#include "main.h"
+#include "sim.hpp"
+
+/**
+ * Runs coroutine autons that don't drive on the sim clock.
+ */
+
+namespace {
+int testStart = 0;
+int finished = 0;
+
+// Runs a test on its own sim task so co::run() ticks on the sim clock
+void simRun(std::function<void()> test) {
+  int task = sim::taskCreate(
+      [test]() {
+        testStart = pros::millis();
+        test();
+      },
+      TASK_PRIORITY_DEFAULT, "test");
+  CHECK(sim::runUntil([task]() { return sim::taskDone(task); }, 10000));
+}
+
+co::Task waitAndCount(int time) {
+  co_await co::delay(time);
+  finished++;
+}
+
+// Eight at once, more than one whenAll() holds in a test without getting silly
+co::Task eight(int time) {
+  co_await co::whenAll(waitAndCount(time), waitAndCount(time + 10), waitAndCount(time + 20), waitAndCount(time + 30),
+                       waitAndCount(time + 40), waitAndCount(time + 50), waitAndCount(time + 60), waitAndCount(time + 70));
+}
+}  // namespace
+
+int main() {
+  sim::config().quiet = true;
+
+  // Waits line up with the ticks
+  simRun([]() {
+    co::run([]() -> co::Task { co_await co::delay(100); }());
+    CHECK((int)pros::millis() - testStart == 100);
+  });
+
+  // More waiting at once than the waiter table starts with, nothing gets left behind
+  simRun([]() {
+    finished = 0;
+    co::run([]() -> co::Task {
+      co_await co::whenAll(eight(100), eight(200), eight(300), eight(400), eight(500));
+    }());
+    CHECK(finished == 40);
+    CHECK((int)pros::millis() - testStart == 570);
+  });
+
+  checkExit("coro_test");
+}
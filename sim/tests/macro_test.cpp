@@ -0,0 +1,170 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "main.h"
+#include "sim.hpp"
+
+/**
+ * Steps a Macro through its stages on the sim clock, ticking it every 10ms
+ * the way the intake job does.
+ */
+
+namespace {
+struct Fired {
+  std::string name;
+  int time;  // ms since the test started
+};
+
+std::vector<Fired> fired;
+int testStart = 0;
+
+Macro::Step step(std::string name, int time) {
+  return {[name]() { fired.push_back({name, (int)pros::millis() - testStart}); }, time};
+}
+
+// Runs a test on its own sim task so pros::millis() and pros::delay() use the sim clock
+void simRun(std::function<void()> test) {
+  fired.clear();
+  int task = sim::taskCreate(
+      [test]() {
+        testStart = pros::millis();
+        test();
+      },
+      TASK_PRIORITY_DEFAULT, "test");
+  CHECK(sim::runUntil([task]() { return sim::taskDone(task); }, 10000));
+}
+
+// Ticks the macro every 10ms until it's done or the time runs out, returns when it finished
+int tickUntilDone(Macro& macro, int timeout) {
+  while (!macro.is_done() && (int)pros::millis() - testStart < timeout) {
+    pros::delay(10);
+    macro.iterate(pros::millis());
+  }
+  return pros::millis() - testStart;
+}
+
+bool firedAt(int index, std::string name, int time) {
+  return index < (int)fired.size() && fired[index].name == name && fired[index].time == time;
+}
+
+struct Stage {
+  int start;  // ms since the macro started
+  int power;  // what it passes to intake.move()
+};
+
+// What the intake motors were told in mV, move() scales -127..127 onto 12V
+int intakeCommand() {
+  return sim::motorState(1).command;
+}
+
+// Ticks one of the real intake macros like intakeControl() and checks the
+// intake every cycle against the stage that should be running by then
+void intakeCheck(Macro& macro, std::vector<Stage> stages, int done) {
+  macro.start(pros::millis());
+  macro.iterate(pros::millis());
+  bool matched = true;
+  while (!macro.is_done() && (int)pros::millis() - testStart < 2000) {
+    int now = (int)pros::millis() - testStart;
+    int power = 0;
+    for (const Stage& stage : stages)
+      if (stage.start <= now) power = stage.power;
+    if (intakeCommand() != power * 12000 / 127) {
+      printf("macro_test: intake at %dmV at %dms, wanted %d\n", intakeCommand(), now, power);
+      matched = false;
+    }
+    pros::delay(10);
+    macro.iterate(pros::millis());
+  }
+  CHECK(matched);
+  CHECK((int)pros::millis() - testStart == done);
+  CHECK(intakeCommand() == 0);
+}
+}  // namespace
+
+int main() {
+  sim::config().quiet = true;
+
+  // Each stage starts once the one before has run for its time, 0ms stages run straight through
+  simRun([]() {
+    Macro macro({step("a", 50), step("b", 0), step("c", 30)});
+    macro.start(pros::millis());
+    CHECK(!macro.is_done());
+    CHECK(tickUntilDone(macro, 500) == 80);
+    CHECK(fired.size() == 3);
+    CHECK(firedAt(0, "a", 0));
+    CHECK(firedAt(1, "b", 50));
+    CHECK(firedAt(2, "c", 50));
+  });
+
+  // A late cycle catches up on every stage that ran out while it was late
+  simRun([]() {
+    Macro macro({step("a", 20), step("b", 20), step("c", 0)});
+    macro.start(pros::millis());
+    pros::delay(10);
+    macro.iterate(pros::millis());
+    pros::delay(35);
+    macro.iterate(pros::millis());
+    CHECK(macro.is_done());
+    CHECK(fired.size() == 3);
+    CHECK(firedAt(1, "b", 45));
+    CHECK(firedAt(2, "c", 45));
+  });
+
+  // Cancel stops it where it is, later ticks don't run anything
+  simRun([]() {
+    Macro macro({step("a", 50), step("b", 0)});
+    macro.start(pros::millis());
+    pros::delay(20);
+    macro.iterate(pros::millis());
+    macro.cancel();
+    CHECK(macro.is_done());
+    for (int i = 0; i < 10; i++) {
+      pros::delay(10);
+      macro.iterate(pros::millis());
+    }
+    CHECK(fired.size() == 1);
+    CHECK(firedAt(0, "a", 0));
+  });
+
+  // Starting it again partway through goes back to the first stage
+  simRun([]() {
+    Macro macro({step("a", 50), step("b", 0)});
+    macro.start(pros::millis());
+    pros::delay(30);
+    macro.iterate(pros::millis());
+    macro.start(pros::millis());
+    CHECK(tickUntilDone(macro, 500) == 80);
+    CHECK(fired.size() == 3);
+    CHECK(firedAt(1, "a", 30));
+    CHECK(firedAt(2, "b", 80));
+  });
+
+  // Nothing to run is done straight away
+  simRun([]() {
+    Macro macro({});
+    macro.start(pros::millis());
+    CHECK(macro.is_done());
+  });
+
+  // The unjam backs the ring off for 50ms, seen on the first tick after
+  simRun([]() { intakeCheck(intakeReverse, {{0, -40}, {50, 0}}, 50); });
+
+  // Seven 65ms pulses with 10ms gaps, then the same back off.  Stages start
+  // on their own schedule, so the intake changes on the first tick after
+  simRun([]() {
+    std::vector<Stage> stages;
+    for (int pulse = 0; pulse < 7; pulse++) {
+      stages.push_back({pulse * 75, 127});
+      stages.push_back({pulse * 75 + 65, 0});
+    }
+    stages.push_back({525, -40});
+    stages.push_back({575, 0});
+    // Runs out at 65, 140, 215..., the ticks land on 70, 140, 220...
+    for (Stage& stage : stages) stage.start = (stage.start + 9) / 10 * 10;
+    intakeCheck(intakePulse, stages, 580);
+  });
+
+  checkExit("macro_test");
+}
@@ -0,0 +1,124 @@
+#include <cmath>
+
+#include "check.hpp"
+#include "main.h"
+#include "sim.hpp"
+
+/**
+ * Runs motions on the simulated chassis and checks what MotionWait says about
+ * them, the numbers the auton timing report is made of.
+ */
+
+namespace {
+// Runs a test on its own sim task once initialize() has set the robot up
+void simRun(std::function<void()> test) {
+  int task = sim::taskCreate(test, TASK_PRIORITY_DEFAULT, "test");
+  CHECK(sim::runUntil([task]() { return sim::taskDone(task); }, 30000));
+}
+
+struct Waited {
+  ez::exit_output exit;
+  int time;    // ms from the target being set to the exit
+  int settle;  // ms MotionWait counted as settling
+};
+
+// Checks straight after the target is set like pid_wait() does, then every cycle
+Waited waitFor(MotionWait& wait) {
+  int start = pros::millis();
+  wait.reset();
+  ez::exit_output exit = wait.iterate();
+  while (exit == ez::RUNNING && (int)pros::millis() - start < 5000) {
+    pros::delay(ez::util::DELAY_TIME);
+    exit = wait.iterate();
+  }
+  return {exit, (int)pros::millis() - start, wait.settle_time_get()};
+}
+
+// Settling is the tail of a motion, not all of it
+void settleCheck(Waited waited) {
+  CHECK(waited.exit != ez::RUNNING);
+  CHECK(waited.settle > 0);
+  CHECK(waited.settle < waited.time - 200);
+}
+}  // namespace
+
+int main() {
+  sim::config().quiet = true;
+
+  int init = sim::taskCreate(initialize, TASK_PRIORITY_DEFAULT, "initialize");
+  CHECK(sim::runUntil([init]() { return sim::taskDone(init); }, 10000));
+
+  // Each motion starts right after the last one settled, so the PID's own
+  // error is still the last motion's when MotionWait first looks
+  simRun([]() {
+    executor.mode_set(RUN_AUTONOMOUS);
+    chassis.pid_targets_reset();
+    odomImuReset();
+    odomSensorsReset();
+    chassis.drive_brake_set(MOTOR_BRAKE_HOLD);
+
+    MotionWait wait;
+    chassis.pid_drive_set(24, 110);
+    settleCheck(waitFor(wait));
+    chassis.pid_drive_set(-24, 110);
+    settleCheck(waitFor(wait));
+    chassis.pid_turn_set(90, 90);
+    settleCheck(waitFor(wait));
+    chassis.pid_turn_set(0, 90);
+    settleCheck(waitFor(wait));
+    chassis.pid_swing_set(ez::LEFT_SWING, 45, 90);
+    settleCheck(waitFor(wait));
+  });
+
+  // Odom points get reached, even ones inside the settle radius off to the side
+  simRun([]() {
+    MotionWait wait;
+    for (double side : {4.0, -3.0, 20.0}) {
+      Pose start = odomGet();
+      double heading = start.theta * M_PI / 180.0;
+      double x = start.x + side * std::cos(heading) + 2 * std::sin(heading);
+      double y = start.y - side * std::sin(heading) + 2 * std::cos(heading);
+      odomPointSet(x * okapi::inch, y * okapi::inch, 110);
+      Waited waited = waitFor(wait);
+      CHECK(waited.exit == ez::SMALL_EXIT || waited.exit == ez::BIG_EXIT);
+      Pose end = odomGet();
+      CHECK(std::hypot(end.x - x, end.y - y) < chassis.leftPID.exit.big_error);
+    }
+  });
+
+  // Pose motions end on the point facing the heading, driving either way
+  simRun([]() {
+    MotionWait wait;
+    for (bool backwards : {false, true}) {
+      Pose start = odomGet();
+      double heading = start.theta * M_PI / 180.0;
+      // 30in along the way it's driving and 15in to the right, turned 60deg toward it
+      double along = backwards ? -30 : 30;
+      double x = start.x + along * std::sin(heading) + 15 * std::cos(heading);
+      double y = start.y + along * std::cos(heading) - 15 * std::sin(heading);
+      double theta = start.theta + (backwards ? -60 : 60);
+      odomPoseSet(x * okapi::inch, y * okapi::inch, theta * okapi::degree, 110, backwards);
+      Waited waited = waitFor(wait);
+      CHECK(waited.exit == ez::SMALL_EXIT || waited.exit == ez::BIG_EXIT);
+      Pose end = odomGet();
+      CHECK(std::hypot(end.x - x, end.y - y) < chassis.leftPID.exit.big_error);
+      CHECK(std::abs(end.theta - theta) < chassis.turnPID.exit.big_error);
+    }
+  });
+
+  // A spline from wherever the robot is, followed with co::path()
+  simRun([]() {
+    Pose start = odomGet();
+    double heading = start.theta * M_PI / 180.0;
+    // 30in ahead and 20in to the right, facing right
+    Pose end = {start.x + 30 * std::sin(heading) + 20 * std::cos(heading), start.y + 30 * std::cos(heading) - 20 * std::sin(heading), start.theta + 90};
+    Path path = splinePath({start, end});
+    ez::exit_output exit = ez::RUNNING;
+    co::run([](const Path& path, ez::exit_output& exit) -> co::Task { exit = co_await co::path(path, 110); }(path, exit));
+    CHECK(exit == ez::SMALL_EXIT || exit == ez::BIG_EXIT);
+    Pose reached = odomGet();
+    CHECK(std::hypot(reached.x - end.x, reached.y - end.y) < chassis.leftPID.exit.big_error);
+  });
+
+  checkExit("motion_test");
+}
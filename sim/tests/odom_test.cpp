@@ -0,0 +1,162 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "main.h"
+#include "sim.hpp"
+
+/**
+ * Replays sensor traces recorded from the sim through odomUpdate() and checks
+ * the pose against where the robot really was.  Record a trace with
+ * bin/sim/robot --trace sim/tests/traces/name.csv "AUTON".
+ */
+
+namespace {
+struct Row {
+  OdomSample sample;
+  sim::Pose real;
+};
+
+std::vector<Row> traceLoad(std::string name) {
+  std::vector<Row> rows;
+  std::string path = std::string(SIM_TESTS_DIR) + "/traces/" + name;
+  FILE* file = fopen(path.c_str(), "r");
+  if (!file) {
+    printf("odom_test: can't read %s\n", path.c_str());
+    return rows;
+  }
+  char header[128];
+  if (!fgets(header, sizeof(header), file)) return rows;
+  Row row;
+  while (fscanf(file, "%lf,%lf,%lf,%lf,%lf,%lf", &row.sample.left, &row.sample.right, &row.sample.imu, &row.real.x, &row.real.y, &row.real.theta) == 6)
+    rows.push_back(row);
+  fclose(file);
+  return rows;
+}
+
+// Runs on a sim task, odomSet() waits on the sim clock
+void simRun(std::function<void()> test) {
+  int task = sim::taskCreate(test, TASK_PRIORITY_DEFAULT, "test");
+  CHECK(sim::runUntil([task]() { return sim::taskDone(task); }, 10000));
+}
+
+// Starts odometry over at the origin, the next sample is the new baseline
+void odomRestart() {
+  odomSet(Pose());
+}
+
+// Sensor reads after a reset partway through, what they'd read from then on
+struct Reset {
+  int row = -1;
+  bool sensors = false;
+  bool imu = false;
+  bool flagged = true;  // false is EZ resetting on its own
+};
+
+Pose replay(const std::vector<Row>& rows, Reset reset = {}) {
+  odomRestart();
+  double left_offset = 0, right_offset = 0, imu_offset = 0;
+  for (int i = 0; i < (int)rows.size(); i++) {
+    OdomSample sample = rows[i].sample;
+    sample.left -= left_offset;
+    sample.right -= right_offset;
+    sample.imu -= imu_offset;
+    odomUpdate(sample);
+
+    // Like odomIterate(), the reset happens right after a read and gets read straight away
+    if (i == reset.row) {
+      if (reset.sensors) {
+        left_offset = rows[i].sample.left;
+        right_offset = rows[i].sample.right;
+      }
+      if (reset.imu) imu_offset = rows[i].sample.imu;
+      OdomSample after = rows[i].sample;
+      after.left -= left_offset;
+      after.right -= right_offset;
+      after.imu -= imu_offset;
+      after.sensors_reset = reset.sensors && reset.flagged;
+      after.imu_reset = reset.imu && reset.flagged;
+      odomUpdate(after);
+    }
+  }
+  return odomGet();
+}
+
+double distance(Pose a, Pose b) {
+  return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+// First row both sides have moved but are still under the jump guard
+int rowUnder(const std::vector<Row>& rows, double most) {
+  for (int i = 0; i < (int)rows.size(); i++) {
+    double left = std::abs(rows[i].sample.left), right = std::abs(rows[i].sample.right);
+    if (left > 0.5 && right > 0.5 && left < most && right < most) return i;
+  }
+  return -1;
+}
+
+void traceCheck(std::string name) {
+  std::vector<Row> rows = traceLoad(name);
+  CHECK(rows.size() > 100);
+  if (rows.size() <= 100) return;
+
+  // Follows the real robot the whole way
+  odomRestart();
+  double worst = 0, worst_heading = 0;
+  for (const Row& row : rows) {
+    odomUpdate(row.sample);
+    Pose pose = odomGet();
+    worst = std::max(worst, distance(pose, {row.real.x, row.real.y, row.real.theta}));
+    worst_heading = std::max(worst_heading, std::abs(pose.theta - row.real.theta));
+  }
+  // The IMU only updates every 10ms, so it's a few degrees behind in a fast turn
+  if (worst > 1.5 || worst_heading > 4) printf("odom_test: %s was off by %.2fin and %.2fdeg\n", name.c_str(), worst, worst_heading);
+  CHECK(worst < 1.5);
+  CHECK(worst_heading < 4);
+  Pose plain = odomGet();
+  CHECK(std::abs(plain.theta - rows.back().real.theta) < 0.5);
+
+  // A drive sensor reset under the jump guard doesn't move the pose
+  int small = rowUnder(rows, 3.0);
+  CHECK(small >= 0);
+  Pose sensors = replay(rows, {small, true, false});
+  CHECK(distance(sensors, plain) < 1e-6);
+  CHECK(std::abs(sensors.theta - plain.theta) < 1e-6);
+
+  // Nor does an IMU reset, at a row that's turned
+  int turned = -1;
+  for (int i = 0; i < (int)rows.size() && turned < 0; i++)
+    if (std::abs(rows[i].sample.imu) > 20) turned = i;
+  CHECK(turned >= 0);
+  Pose imu = replay(rows, {turned, false, true});
+  CHECK(distance(imu, plain) < 1e-6);
+  CHECK(std::abs(imu.theta - plain.theta) < 1e-6);
+
+  // Both at once halfway through
+  Pose both = replay(rows, {(int)rows.size() / 2, true, true});
+  CHECK(distance(both, plain) < 1e-6);
+  CHECK(std::abs(both.theta - plain.theta) < 1e-6);
+
+  // Resets nobody said anything about are caught by the jump guard when
+  // they're big enough, losing at most a cycle of driving
+  int far = -1;
+  for (int i = 0; i < (int)rows.size() && far < 0; i++)
+    if (std::abs(rows[i].sample.left) > 20 && std::abs(rows[i].sample.right) > 20 && std::abs(rows[i].sample.imu) > 50) far = i;
+  if (far >= 0) {
+    Pose unflagged = replay(rows, {far, true, true, false});
+    CHECK(distance(unflagged, plain) < 1.0);
+    CHECK(std::abs(unflagged.theta - plain.theta) < 1.0);
+  }
+}
+}  // namespace
+
+int main() {
+  sim::config().quiet = true;
+
+  simRun([]() { traceCheck("blue_positive.csv"); });
+  simRun([]() { traceCheck("blue_elims_negative.csv"); });
+
+  checkExit("odom_test");
+}
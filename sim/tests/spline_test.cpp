@@ -0,0 +1,98 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "main.h"
+
+/**
+ * Makes splines and reads them back from the cache file, including files
+ * that were cut short or have a bad point count.
+ */
+
+namespace {
+const std::string FILE_NAME = std::string(P_tmpdir) + "/spline_test.bin";
+const std::vector<Pose> POSES = {{0, 0, 0}, {-10, 30, -20}, {-24, 44, -90}};
+
+std::vector<char> fileRead() {
+  std::vector<char> bytes;
+  FILE* file = fopen(FILE_NAME.c_str(), "rb");
+  if (!file) return bytes;
+  char buffer[256];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.insert(bytes.end(), buffer, buffer + read);
+  fclose(file);
+  return bytes;
+}
+
+void fileWrite(const std::vector<char>& bytes) {
+  FILE* file = fopen(FILE_NAME.c_str(), "wb");
+  fwrite(bytes.data(), 1, bytes.size(), file);
+  fclose(file);
+}
+
+// Adding it again forgets the path, like a fresh start before splinesLoad()
+void splineForget() {
+  splineAdd("test", POSES);
+}
+
+bool samePath(const Path& a, const Path& b) {
+  if (a.size() != b.size()) return false;
+  for (int i = 0; i < a.size(); i++) {
+    // Stored as floats
+    if (std::abs(a.x[i] - b.x[i]) > 1e-4 || std::abs(a.y[i] - b.y[i]) > 1e-4) return false;
+  }
+  return true;
+}
+}  // namespace
+
+int main() {
+  Path made = splinePath(POSES);
+
+  // Goes through every pose and ends on the last one
+  CHECK(made.size() > 50);
+  CHECK(std::abs(made.x.front()) < 1e-9 && std::abs(made.y.front()) < 1e-9);
+  CHECK(std::abs(made.x.back() + 24) < 1e-9 && std::abs(made.y.back() - 44) < 1e-9);
+  bool middle = false;
+  for (int i = 0; i < made.size(); i++)
+    if (std::hypot(made.x[i] + 10, made.y[i] - 30) < 0.6) middle = true;
+  CHECK(middle);
+
+  // Points that don't pair up don't make a path
+  CHECK(Path({0, 1, 2}, {0, 1}).size() == 0);
+  CHECK(Path({0, 1, 2}, {0, 1, 2}).size() == 3);
+
+  // Reads back what was written
+  splineForget();
+  CHECK(splinesWrite(FILE_NAME.c_str()));
+  std::vector<char> good = fileRead();
+  splineForget();
+  CHECK(splinesRead(FILE_NAME.c_str()) == 1);
+  CHECK(samePath(splineGet("test"), made));
+
+  // Changed poses don't match the file
+  splineAdd("test", {{0, 0, 0}, {0, 24, 0}});
+  CHECK(splinesRead(FILE_NAME.c_str()) == 0);
+
+  // Cut off partway through the points
+  splineForget();
+  fileWrite(std::vector<char>(good.begin(), good.end() - 9));
+  CHECK(splinesRead(FILE_NAME.c_str()) == 0);
+
+  // A point count far past the end of the file stops the read instead of allocating it
+  std::vector<char> bad = good;
+  uint32_t points = 0xfffffff0;
+  memcpy(bad.data() + 4 + sizeof(uint32_t) + sizeof(uint64_t), &points, sizeof(points));
+  fileWrite(bad);
+  CHECK(splinesRead(FILE_NAME.c_str()) == 0);
+
+  // Not a spline file
+  fileWrite({'n', 'o', 'p', 'e'});
+  CHECK(splinesRead(FILE_NAME.c_str()) == 0);
+  CHECK(splinesRead("/nonexistent/splines.bin") == 0);
+
+  remove(FILE_NAME.c_str());
+  checkExit("spline_test");
+}
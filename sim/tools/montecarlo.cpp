@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "work_pool.hpp"
+
+/**
+ * Runs autons thousands of times in the sim with the robot set up a little
+ * differently every time, to see which ones hold up.  Every run gets a
+ * different start pose, battery, IMU scale error and wheel friction, and is
+ * checked against a run with everything nominal.
+ *
+ * bin/sim/montecarlo [--runs n] [--jobs n] [--seed n] [--tolerance in] [--angle-tolerance deg] [auton]...
+ *
+ * autons are names or page numbers from the selector, all of them by default.
+ */
+
+struct Run {
+  bool ok = false;  // The sim ran and printed a result
+  bool finished = false;
+  double time = 0;
+  double x = 0;
+  double y = 0;
+  double theta = 0;
+  std::string settings;
+};
+
+static std::string robot;
+
+// Runs bin/sim/robot and reads its csv line
+static Run simRun(std::string args) {
+  Run run;
+  run.settings = args;
+  std::string command = robot + " --quiet --csv " + args + " 2>/dev/null";
+  FILE* pipe = popen(command.c_str(), "r");
+  if (!pipe) return run;
+
+  char line[512] = "";
+  bool read = fgets(line, sizeof(line), pipe) != nullptr;
+  pclose(pipe);
+  if (!read) return run;
+
+  // The name comes first and can have spaces, so read the numbers off the end
+  std::string text = line;
+  std::size_t comma = std::string::npos;
+  for (int i = 0; i < 5; i++) {
+    comma = text.rfind(',', comma == std::string::npos ? std::string::npos : comma - 1);
+    if (comma == std::string::npos) return run;
+  }
+  int finished = 0;
+  if (sscanf(text.c_str() + comma, ",%i,%lf,%lf,%lf,%lf", &finished, &run.time, &run.x, &run.y, &run.theta) != 5) return run;
+  run.finished = finished;
+  run.ok = true;
+  return run;
+}
+
+// Start pose, battery, IMU scale and slip for one run
+static std::string settingsRandom(std::uint32_t seed) {
+  std::mt19937 random(seed);
+  std::normal_distribution<double> placement(0, 0.5);
+  std::normal_distribution<double> placement_angle(0, 1.0);
+  std::uniform_real_distribution<double> battery(11.8, 12.9);
+  std::normal_distribution<double> imu_scale(1.0115, 0.003);
+  std::uniform_real_distribution<double> friction(0.6, 1.0);
+
+  char settings[256];
+  snprintf(settings, sizeof(settings), "--seed %u --set start_x=%.3f --set start_y=%.3f --set start_theta=%.3f --set battery=%.3f --set imu_scale=%.5f --set wheel_friction=%.3f",
+           seed, placement(random), placement(random), placement_angle(random), battery(random), imu_scale(random), friction(random));
+  return settings;
+}
+
+static double percentile(std::vector<double> values, double p) {
+  if (values.empty()) return 0;
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, (std::size_t)(p * (values.size() - 1) + 0.5))];
+}
+
+static double deviation(const std::vector<double>& values) {
+  if (values.size() < 2) return 0;
+  double mean = 0;
+  for (double value : values) mean += value;
+  mean /= values.size();
+  double sum = 0;
+  for (double value : values) sum += (value - mean) * (value - mean);
+  return std::sqrt(sum / (values.size() - 1));
+}
+
+static void usage() {
+  printf("usage: montecarlo [--runs n] [--jobs n] [--seed n] [--tolerance in] [--angle-tolerance deg] [auton]...\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int runs = 1000;
+  int jobs = 0;
+  std::uint32_t seed = 1;
+  double tolerance = 3;
+  double angle_tolerance = 5;
+  std::vector<std::string> autons;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--runs") && i + 1 < argc)
+      runs = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--jobs") && i + 1 < argc)
+      jobs = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+      seed = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc)
+      tolerance = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--angle-tolerance") && i + 1 < argc)
+      angle_tolerance = atof(argv[++i]);
+    else if (argv[i][0] == '-')
+      usage();
+    else
+      autons.push_back(argv[i]);
+  }
+
+  // The robot program sits next to this
+  robot = argv[0];
+  std::size_t slash = robot.rfind('/');
+  robot = (slash == std::string::npos ? std::string(".") : robot.substr(0, slash)) + "/robot";
+
+  // Page numbers from the selector
+  std::vector<std::pair<int, std::string>> pages;
+  FILE* pipe = popen((robot + " --quiet --list").c_str(), "r");
+  if (!pipe) {
+    printf("montecarlo: can't run %s\n", robot.c_str());
+    return 1;
+  }
+  char line[256];
+  while (fgets(line, sizeof(line), pipe)) {
+    char* colon = strchr(line, ':');
+    if (!colon) continue;
+    std::string name = colon + 2;
+    name.erase(name.find_last_not_of("\r\n") + 1);
+    pages.push_back({atoi(line), name});
+  }
+  pclose(pipe);
+
+  std::vector<std::pair<int, std::string>> selected;
+  for (auto& page : pages) {
+    bool wanted = autons.empty();
+    for (auto& auton : autons) {
+      if (auton == page.second || auton == std::to_string(page.first)) wanted = true;
+    }
+    if (wanted) selected.push_back(page);
+  }
+  if (selected.empty()) {
+    printf("montecarlo: no autons to run, see %s --list\n", robot.c_str());
+    return 2;
+  }
+
+  WorkPool pool(jobs);
+  printf("%i runs of %i autons on %i threads\n\n", runs, (int)selected.size(), pool.size());
+
+  for (auto& page : selected) {
+    Run nominal;
+    std::vector<Run> results(runs);
+    pool.push([&nominal, &page]() { nominal = simRun(std::to_string(page.first)); });
+    for (int i = 0; i < runs; i++) {
+      std::uint32_t run_seed = seed + i;
+      pool.push([&results, &page, i, run_seed]() { results[i] = simRun(settingsRandom(run_seed) + " " + std::to_string(page.first)); });
+    }
+    pool.wait();
+
+    printf("%s\n", page.second.c_str());
+    if (!nominal.ok) {
+      printf("  the nominal run failed, try %s %i\n\n", robot.c_str(), page.first);
+      continue;
+    }
+
+    int finished = 0, success = 0, crashed = 0;
+    std::vector<double> times, xs, ys, thetas, misses;
+    const Run* worst = nullptr;
+    double worst_miss = -1;
+    for (auto& run : results) {
+      if (!run.ok) {
+        crashed++;
+        continue;
+      }
+      double miss = std::hypot(run.x - nominal.x, run.y - nominal.y);
+      double angle_miss = std::abs(run.theta - nominal.theta);
+      if (run.finished) {
+        finished++;
+        times.push_back(run.time);
+      }
+      if (run.finished && miss <= tolerance && angle_miss <= angle_tolerance) success++;
+      xs.push_back(run.x);
+      ys.push_back(run.y);
+      thetas.push_back(run.theta);
+      misses.push_back(miss);
+      if (miss > worst_miss) {
+        worst_miss = miss;
+        worst = &run;
+      }
+    }
+
+    printf("  success   %5.1f%%  finished within %.1fin and %.1fdeg of the nominal end\n", 100.0 * success / runs, tolerance, angle_tolerance);
+    printf("  finished  %5.1f%%\n", 100.0 * finished / runs);
+    if (crashed) printf("  crashed   %5i    runs that didn't print a result\n", crashed);
+    printf("  end pose  nominal x %.2fin y %.2fin theta %.2fdeg\n", nominal.x, nominal.y, nominal.theta);
+    printf("            spread  x %.2fin y %.2fin theta %.2fdeg (standard deviation)\n", deviation(xs), deviation(ys), deviation(thetas));
+    printf("            miss    p50 %.2fin  p90 %.2fin  p99 %.2fin\n", percentile(misses, 0.5), percentile(misses, 0.9), percentile(misses, 0.99));
+    printf("  time      nominal %.2fs  p50 %.2fs  p90 %.2fs  p99 %.2fs  max %.2fs\n", nominal.time, percentile(times, 0.5), percentile(times, 0.9), percentile(times, 0.99), percentile(times, 1));
+    if (worst) printf("  worst     %s %s\n", robot.c_str(), worst->settings.c_str());
+    printf("\n");
+    fflush(stdout);
+  }
+  return 0;
+}
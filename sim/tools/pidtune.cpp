@@ -0,0 +1,442 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "work_pool.hpp"
+
+/**
+ * Searches for PID constants and exit conditions in the sim instead of by hand
+ * with the PID tuner.  Each candidate runs bin/sim/robot --tune, a fixed set of
+ * motions, on a few batteries and tiles, and the search (CMA-ES) keeps
+ * whatever settles fastest without going past the overshoot or final error
+ * limits.  Then it prints default_constants() from src/autons.cpp with the
+ * new numbers in it.
+ *
+ * bin/sim/pidtune [--generations n] [--population n] [--jobs n] [--seed n] [--overshoot x] [--tolerance x] [--source file] [drive|turn|swing]...
+ *
+ * --overshoot and --tolerance are in inches for drive and degrees for turns
+ * and swings, by default 1in/1in for drive and 2deg/2deg for the others.
+ */
+
+using Settings = std::map<std::string, std::vector<double>>;
+
+// One number being searched, ie. turn kd.  The search sees it as 0 to 1.
+struct Param {
+  std::string setting;
+  int index;
+  double low;
+  double high;
+  bool log;
+
+  double value(double x) const {
+    x = std::clamp(x, 0.0, 1.0);
+    return log ? low * std::pow(high / low, x) : low + (high - low) * x;
+  }
+  double position(double value) const {
+    value = std::clamp(value, low, high);
+    return log ? std::log(value / low) / std::log(high / low) : (value - low) / (high - low);
+  }
+};
+
+struct Score {
+  double cost = 1e9;
+  double settle = 0;
+  double overshoot = 0;
+  double error = 0;
+  double heading = 0;
+  bool finished = false;
+};
+
+static std::string robot;
+
+// Each candidate runs on all of these, the search has to work on all of them
+static const std::vector<std::string> conditions = {
+    "--seed 1",
+    "--seed 2 --set battery=12.0",
+    "--seed 3 --set battery=11.8 --set wheel_friction=0.7",
+};
+
+static std::string settingString(const std::string& name, const std::vector<double>& values) {
+  std::string text = name + "=";
+  for (std::size_t i = 0; i < values.size(); i++) {
+    char number[32];
+    snprintf(number, sizeof(number), "%s%.6g", i ? "," : "", values[i]);
+    text += number;
+  }
+  return text;
+}
+
+// Runs bin/sim/robot --tune and reads back its constants and result
+static bool tuneRun(std::string motion, std::string args, Settings& settings) {
+  std::string command = robot + " --quiet --tune " + motion + " " + args + " 2>/dev/null";
+  FILE* pipe = popen(command.c_str(), "r");
+  if (!pipe) return false;
+  char line[256];
+  while (fgets(line, sizeof(line), pipe)) {
+    char* equals = strchr(line, '=');
+    if (!equals) continue;
+    std::vector<double> values;
+    for (char* value = equals; value; value = strchr(value + 1, ',')) values.push_back(atof(value + 1));
+    settings[std::string(line, equals)] = values;
+  }
+  pclose(pipe);
+  return settings.count("result");
+}
+
+// The constants a candidate changes, on top of what the robot already has
+static Settings candidate(const Settings& current, const std::vector<Param>& params, const std::vector<double>& x) {
+  Settings settings;
+  for (auto& param : params) {
+    if (!settings.count(param.setting)) settings[param.setting] = current.at(param.setting);
+  }
+  for (std::size_t i = 0; i < params.size(); i++) {
+    double value = params[i].value(x[i]);
+    if (params[i].index == 0 && params[i].setting.find("_exit") != std::string::npos) value = std::round(value / 10) * 10;  // Exit times are in 10ms loops
+    settings[params[i].setting][params[i].index] = value;
+  }
+  // The big exit has to be looser than the small one
+  for (auto& setting : settings) {
+    if (setting.first.find("_exit") == std::string::npos) continue;
+    auto& exit = setting.second;
+    exit[3] = std::max(exit[3], exit[1] * 2);
+    exit[2] = std::max(exit[2], exit[0]);
+  }
+  return settings;
+}
+
+static std::string settingArgs(const Settings& settings) {
+  std::string args;
+  for (auto& setting : settings) args += " --pid " + settingString(setting.first, setting.second);
+  return args;
+}
+
+static Score score(const std::vector<Settings>& results, bool drive, double overshoot, double tolerance) {
+  Score score;
+  score.finished = true;
+  for (auto& result : results) {
+    auto found = result.find("result");
+    if (found == result.end() || found->second.size() < 5 || !found->second[4]) {
+      score.finished = false;
+      continue;
+    }
+    auto& r = found->second;
+    score.settle += r[0] / results.size();
+    score.overshoot = std::max(score.overshoot, r[1]);
+    score.error = std::max(score.error, r[2]);
+    score.heading = std::max(score.heading, r[3]);
+  }
+  if (!score.finished) return score;
+
+  // Seconds to settle, with anything over a limit costing a lot more than it could save
+  score.cost = score.settle;
+  score.cost += 10 * std::max(0.0, score.overshoot - overshoot);
+  score.cost += 10 * std::max(0.0, score.error - tolerance);
+  if (drive) score.cost += 5 * std::max(0.0, score.heading - 1.0);
+  return score;
+}
+
+// Eigenvectors and values of a symmetric matrix, Jacobi rotations are plenty for a few dimensions
+static void eigen(std::vector<std::vector<double>> a, std::vector<std::vector<double>>& vectors, std::vector<double>& values) {
+  int n = a.size();
+  vectors.assign(n, std::vector<double>(n, 0));
+  for (int i = 0; i < n; i++) vectors[i][i] = 1;
+  for (int sweep = 0; sweep < 50; sweep++) {
+    double off = 0;
+    for (int p = 0; p < n; p++)
+      for (int q = p + 1; q < n; q++) off += a[p][q] * a[p][q];
+    if (off < 1e-20) break;
+    for (int p = 0; p < n; p++) {
+      for (int q = p + 1; q < n; q++) {
+        if (std::abs(a[p][q]) < 1e-30) continue;
+        double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+        double t = (theta >= 0 ? 1 : -1) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+        double c = 1 / std::sqrt(t * t + 1), s = t * c;
+        for (int k = 0; k < n; k++) {
+          double akp = a[k][p], akq = a[k][q];
+          a[k][p] = c * akp - s * akq;
+          a[k][q] = s * akp + c * akq;
+        }
+        for (int k = 0; k < n; k++) {
+          double apk = a[p][k], aqk = a[q][k];
+          a[p][k] = c * apk - s * aqk;
+          a[q][k] = s * apk + c * aqk;
+        }
+        for (int k = 0; k < n; k++) {
+          double vkp = vectors[k][p], vkq = vectors[k][q];
+          vectors[k][p] = c * vkp - s * vkq;
+          vectors[k][q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+  values.resize(n);
+  for (int i = 0; i < n; i++) values[i] = std::max(a[i][i], 1e-20);
+}
+
+// What gets searched for a motion, around what the robot has now
+static std::vector<Param> paramsFor(std::string motion, const Settings& current, double tolerance) {
+  std::vector<Param> params;
+  auto gains = [&](std::string setting) {
+    auto& constants = current.at(setting);
+    for (int i = 0; i < 4; i++) {
+      // A 0 stays 0, ie. no i term
+      if (constants[i] > 0) params.push_back({setting, i, constants[i] / 8, constants[i] * 8, true});
+    }
+  };
+  gains(motion);
+  if (motion == "drive") gains("heading");
+  std::string exit = motion + "_exit";
+  params.push_back({exit, 0, 40, 300, false});  // Any shorter and one lucky sample ends the motion
+  params.push_back({exit, 1, tolerance / 8, tolerance, true});
+  return params;
+}
+
+static std::string number(double value) {
+  char text[32];
+  snprintf(text, sizeof(text), "%.3g", value);
+  return text;
+}
+
+static std::string constantsCall(std::string setting, const std::vector<double>& v) {
+  std::string args = number(v[0]) + ", " + number(v[1]) + ", " + number(v[2]);
+  if (v[3] != 0) args += ", " + number(v[3]);
+  return "pid_" + setting + "_constants_set(" + args + ")";
+}
+
+static std::string exitCall(std::string setting, const std::vector<double>& v) {
+  std::string motion = setting.substr(0, setting.size() - 5);
+  std::string unit = motion == "drive" ? "_in" : "_deg";
+  char args[256];
+  snprintf(args, sizeof(args), "%.0f_ms, %s%s, %.0f_ms, %s%s, %.0f_ms, %.0f_ms", v[0], number(v[1]).c_str(), unit.c_str(), v[2], number(v[3]).c_str(), unit.c_str(), v[4], v[5]);
+  return "pid_" + motion + "_exit_condition_set(" + args + ")";
+}
+
+// Prints default_constants() from the source with the new numbers, or just the new lines if it can't be found
+static void constantsPrint(std::string source, const Settings& settings) {
+  std::map<std::string, std::string> calls;
+  for (auto& setting : settings) {
+    if (setting.first == "result") continue;
+    if (setting.first.find("_exit") != std::string::npos)
+      calls["pid_" + setting.first.substr(0, setting.first.size() - 5) + "_exit_condition_set("] = exitCall(setting.first, setting.second);
+    else
+      calls["pid_" + setting.first + "_constants_set("] = constantsCall(setting.first, setting.second);
+  }
+
+  std::ifstream file(source);
+  std::string line;
+  bool inside = false, found = false;
+  std::stringstream out;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.find("void default_constants()") == 0) inside = found = true;
+    if (!inside) continue;
+    for (auto& call : calls) {
+      std::size_t start = line.find(call.first);
+      if (start == std::string::npos) continue;
+      std::size_t end = line.find(')', start);
+      if (end != std::string::npos) line = line.substr(0, start) + call.second + line.substr(end + 1);
+    }
+    out << line << "\n";
+    if (line == "}") break;
+  }
+
+  if (found) {
+    printf("%s", out.str().c_str());
+    return;
+  }
+  printf("void default_constants() {\n");
+  for (auto& call : calls) printf("  chassis.%s;\n", call.second.c_str());
+  printf("}\n");
+}
+
+static void usage() {
+  printf("usage: pidtune [--generations n] [--population n] [--jobs n] [--seed n] [--overshoot x] [--tolerance x] [--source file] [drive|turn|swing]...\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int generations = 30;
+  int population = 0;
+  int jobs = 0;
+  std::uint32_t seed = 1;
+  double overshoot_set = -1;
+  double tolerance_set = -1;
+  std::string source = "src/autons.cpp";
+  std::vector<std::string> motions;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--generations") && i + 1 < argc)
+      generations = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--population") && i + 1 < argc)
+      population = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--jobs") && i + 1 < argc)
+      jobs = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+      seed = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--overshoot") && i + 1 < argc)
+      overshoot_set = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc)
+      tolerance_set = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--source") && i + 1 < argc)
+      source = argv[++i];
+    else if (!strcmp(argv[i], "drive") || !strcmp(argv[i], "turn") || !strcmp(argv[i], "swing"))
+      motions.push_back(argv[i]);
+    else
+      usage();
+  }
+  if (motions.empty()) motions = {"drive", "turn", "swing"};
+
+  // The robot program sits next to this
+  robot = argv[0];
+  std::size_t slash = robot.rfind('/');
+  robot = (slash == std::string::npos ? std::string(".") : robot.substr(0, slash)) + "/robot";
+
+  Settings current;
+  if (!tuneRun("drive", "", current)) {
+    printf("pidtune: can't run %s --tune\n", robot.c_str());
+    return 1;
+  }
+  current.erase("result");
+  Settings best_settings = current;
+
+  WorkPool pool(jobs);
+  std::mt19937 random(seed);
+  std::normal_distribution<double> normal;
+
+  for (auto& motion : motions) {
+    bool drive = motion == "drive";
+    double overshoot = overshoot_set >= 0 ? overshoot_set : drive ? 1.0 : 2.0;
+    double tolerance = tolerance_set > 0 ? tolerance_set : drive ? 1.0 : 2.0;
+    std::vector<Param> params = paramsFor(motion, current, tolerance);
+    int n = params.size();
+
+    // Evaluates a batch of candidates across every condition at once
+    auto evaluate = [&](const std::vector<std::vector<double>>& xs) {
+      std::vector<std::vector<Settings>> results(xs.size(), std::vector<Settings>(conditions.size()));
+      for (std::size_t i = 0; i < xs.size(); i++) {
+        std::string args = settingArgs(candidate(current, params, xs[i]));
+        for (std::size_t c = 0; c < conditions.size(); c++) {
+          pool.push([&results, &motion, i, c, args]() { tuneRun(motion, conditions[c] + args, results[i][c]); });
+        }
+      }
+      pool.wait();
+      std::vector<Score> scores;
+      for (std::size_t i = 0; i < xs.size(); i++) {
+        Score s = score(results[i], drive, overshoot, tolerance);
+        // Outside the search box counts as the edge of it, plus a push back in
+        for (int d = 0; d < n; d++) s.cost += 10 * std::pow(xs[i][d] - std::clamp(xs[i][d], 0.0, 1.0), 2);
+        scores.push_back(s);
+      }
+      return scores;
+    };
+
+    std::vector<double> mean(n);
+    for (int d = 0; d < n; d++) mean[d] = params[d].position(current.at(params[d].setting)[params[d].index]);
+    Score start = evaluate({mean})[0];
+    printf("%s: %i numbers, now settles in %.2fs, overshoot %.2f, error %.2f\n", motion.c_str(), n, start.settle, start.overshoot, start.error);
+    fflush(stdout);
+
+    // CMA-ES with the usual defaults, see Hansen's "The CMA Evolution Strategy: A Tutorial"
+    int lambda = population > 0 ? population : 4 + (int)(3 * std::log(n));
+    int mu = lambda / 2;
+    std::vector<double> weights(mu);
+    double sum = 0, sum_sq = 0;
+    for (int i = 0; i < mu; i++) sum += weights[i] = std::log(mu + 0.5) - std::log(i + 1);
+    for (auto& w : weights) {
+      w /= sum;
+      sum_sq += w * w;
+    }
+    double mu_eff = 1 / sum_sq;
+    double cc = (4 + mu_eff / n) / (n + 4 + 2 * mu_eff / n);
+    double cs = (mu_eff + 2) / (n + mu_eff + 5);
+    double c1 = 2 / ((n + 1.3) * (n + 1.3) + mu_eff);
+    double cmu = std::min(1 - c1, 2 * (mu_eff - 2 + 1 / mu_eff) / ((n + 2) * (n + 2) + mu_eff));
+    double damps = 1 + 2 * std::max(0.0, std::sqrt((mu_eff - 1) / (n + 1)) - 1) + cs;
+    double chi = std::sqrt(n) * (1 - 1.0 / (4 * n) + 1.0 / (21.0 * n * n));
+
+    double sigma = 0.2;
+    std::vector<double> pc(n, 0), ps(n, 0);
+    std::vector<std::vector<double>> C(n, std::vector<double>(n, 0)), B;
+    std::vector<double> D;
+    for (int d = 0; d < n; d++) C[d][d] = 1;
+
+    std::vector<double> best = mean;
+    Score best_score = start;
+
+    for (int generation = 0; generation < generations && sigma > 1e-3; generation++) {
+      eigen(C, B, D);
+      for (auto& value : D) value = std::sqrt(value);
+
+      std::vector<std::vector<double>> ys(lambda, std::vector<double>(n)), xs(lambda, std::vector<double>(n));
+      for (int k = 0; k < lambda; k++) {
+        std::vector<double> z(n);
+        for (auto& value : z) value = normal(random);
+        for (int r = 0; r < n; r++) {
+          ys[k][r] = 0;
+          for (int c = 0; c < n; c++) ys[k][r] += B[r][c] * D[c] * z[c];
+          xs[k][r] = mean[r] + sigma * ys[k][r];
+        }
+      }
+
+      std::vector<Score> scores = evaluate(xs);
+      std::vector<int> order(lambda);
+      for (int k = 0; k < lambda; k++) order[k] = k;
+      std::sort(order.begin(), order.end(), [&scores](int a, int b) { return scores[a].cost < scores[b].cost; });
+      if (scores[order[0]].cost < best_score.cost) {
+        best_score = scores[order[0]];
+        best = xs[order[0]];
+      }
+
+      std::vector<double> y_w(n, 0);
+      for (int i = 0; i < mu; i++)
+        for (int d = 0; d < n; d++) y_w[d] += weights[i] * ys[order[i]][d];
+      for (int d = 0; d < n; d++) mean[d] += sigma * y_w[d];
+
+      // C^-1/2 y_w for the step size path
+      std::vector<double> bty(n, 0), inv(n, 0);
+      for (int c = 0; c < n; c++)
+        for (int r = 0; r < n; r++) bty[c] += B[r][c] * y_w[r];
+      for (int r = 0; r < n; r++)
+        for (int c = 0; c < n; c++) inv[r] += B[r][c] * bty[c] / D[c];
+
+      double ps_norm = 0;
+      for (int d = 0; d < n; d++) {
+        ps[d] = (1 - cs) * ps[d] + std::sqrt(cs * (2 - cs) * mu_eff) * inv[d];
+        ps_norm += ps[d] * ps[d];
+      }
+      ps_norm = std::sqrt(ps_norm);
+      bool hsig = ps_norm / std::sqrt(1 - std::pow(1 - cs, 2 * (generation + 1))) / chi < 1.4 + 2.0 / (n + 1);
+      for (int d = 0; d < n; d++) pc[d] = (1 - cc) * pc[d] + (hsig ? std::sqrt(cc * (2 - cc) * mu_eff) : 0) * y_w[d];
+
+      for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+          double rank_mu = 0;
+          for (int i = 0; i < mu; i++) rank_mu += weights[i] * ys[order[i]][r] * ys[order[i]][c];
+          C[r][c] = (1 - c1 - cmu) * C[r][c] + c1 * (pc[r] * pc[c] + (hsig ? 0 : cc * (2 - cc) * C[r][c])) + cmu * rank_mu;
+        }
+      }
+      sigma *= std::exp(cs / damps * (ps_norm / chi - 1));
+
+      printf("  generation %2i: best %.2fs settle, overshoot %.2f, error %.2f, step %.3f\n", generation + 1, best_score.settle, best_score.overshoot, best_score.error, sigma);
+      fflush(stdout);
+    }
+
+    if (best_score.cost < start.cost) {
+      Settings found = candidate(current, params, best);
+      for (auto& setting : found) best_settings[setting.first] = setting.second;
+      printf("%s: %.2fs -> %.2fs settle, overshoot %.2f, error %.2f\n\n", motion.c_str(), start.settle, best_score.settle, best_score.overshoot, best_score.error);
+    } else {
+      printf("%s: nothing beat what's there now\n\n", motion.c_str());
+    }
+  }
+
+  constantsPrint(source, best_settings);
+  return 0;
+}
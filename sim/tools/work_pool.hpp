@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Thread pool for the sim tools.  Every worker has its own queue and takes
+ * from the front of it, and when it runs out it steals from the back of
+ * someone else's, so a few slow sim runs don't leave cores sitting idle.
+ */
+class WorkPool {
+ public:
+  /**
+   * WorkPool constructor.
+   *
+   * \param threads
+   *        Workers to start, 0 uses every core
+   */
+  WorkPool(int threads = 0) {
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threads; i++) workers.push_back(std::unique_ptr<Worker>(new Worker));
+    for (int i = 0; i < threads; i++) workers[i]->thread = std::thread([this, i]() { work(i); });
+  }
+
+  ~WorkPool() {
+    {
+      std::unique_lock<std::mutex> lock(idle_lock);
+      stopping = true;
+    }
+    idle.notify_all();
+    for (auto& worker : workers) worker->thread.join();
+  }
+
+  /**
+   * Adds a job.  Jobs are dealt out to the workers in turn.
+   *
+   * \param job
+   *        Runs on one of the workers
+   */
+  void push(std::function<void()> job) {
+    Worker& worker = *workers[next++ % workers.size()];
+    {
+      std::unique_lock<std::mutex> lock(worker.lock);
+      worker.jobs.push_back(job);
+    }
+    {
+      std::unique_lock<std::mutex> lock(idle_lock);
+      pending++;
+    }
+    idle.notify_one();
+  }
+
+  /**
+   * Blocks until every job that was pushed has finished.
+   */
+  void wait() {
+    std::unique_lock<std::mutex> lock(idle_lock);
+    finished.wait(lock, [this]() { return pending == 0; });
+  }
+
+  /**
+   * Returns how many workers there are.
+   */
+  int size() { return workers.size(); }
+
+ private:
+  struct Worker {
+    std::deque<std::function<void()>> jobs;
+    std::mutex lock;
+    std::thread thread;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::mutex idle_lock;
+  std::condition_variable idle;
+  std::condition_variable finished;
+  int pending = 0;
+  bool stopping = false;
+  std::size_t next = 0;
+
+  // Own queue from the front, everyone else's from the back
+  bool take(int self, std::function<void()>& job) {
+    for (std::size_t i = 0; i < workers.size(); i++) {
+      Worker& worker = *workers[(self + i) % workers.size()];
+      std::unique_lock<std::mutex> lock(worker.lock);
+      if (worker.jobs.empty()) continue;
+      if (i == 0) {
+        job = worker.jobs.front();
+        worker.jobs.pop_front();
+      } else {
+        job = worker.jobs.back();
+        worker.jobs.pop_back();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void work(int self) {
+    while (true) {
+      std::function<void()> job;
+      if (take(self, job)) {
+        job();
+        std::unique_lock<std::mutex> lock(idle_lock);
+        if (--pending == 0) finished.notify_all();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(idle_lock);
+      if (stopping) return;
+      // Something may have been pushed between take() and here, so only sleep briefly
+      idle.wait_for(lock, std::chrono::milliseconds(5));
+    }
+  }
+};
@@ -0,0 +1,93 @@
+#include "action_graph.hpp"
+
+#include "auton_timer.hpp"
+#include "pros/rtos.hpp"
+
+int ActionGraph::add(std::string name, std::function<void()> action, std::vector<int> after, std::function<bool()> trigger, std::function<bool()> done) {
+  Node node;
+  node.name = name;
+  node.action = action;
+  node.after = after;
+  node.trigger = trigger;
+  node.done = done;
+  nodes.push_back(node);
+  return nodes.size() - 1;
+}
+
+int ActionGraph::motion(std::string name, std::function<void()> action, std::vector<int> after, std::function<bool()> trigger) {
+  int id = add(name, action, after, trigger);
+  nodes[id].is_motion = true;
+  return id;
+}
+
+int ActionGraph::wait(std::string name, int time, std::vector<int> after) {
+  int id = add(name, nullptr, after);
+  nodes[id].time = time;
+  return id;
+}
+
+std::function<bool()> ActionGraph::during(int id, std::function<bool()> trigger) {
+  return [this, id, trigger]() { return nodes[id].started && trigger(); };
+}
+
+bool ActionGraph::ready(Node& node) {
+  for (int id : node.after) {
+    if (!nodes[id].finished) return false;
+  }
+  return !node.trigger || node.trigger();
+}
+
+bool ActionGraph::run(int timeout) {
+  int start = pros::millis();
+  std::uint32_t next_wake = start;
+
+  while (true) {
+    int now = pros::millis();
+    bool all_finished = true;
+
+    for (int id = 0; id < (int)nodes.size(); id++) {
+      Node& node = nodes[id];
+      if (node.finished) continue;
+
+      if (!node.started && ready(node)) {
+        node.started = true;
+        node.start_time = now;
+        if (node.is_motion) {
+          // A new motion takes over the chassis from the old one
+          if (active_motion != -1) nodes[active_motion].finished = true;
+          active_motion = id;
+          if (node.action) node.action();
+          motion_wait.reset();
+        } else if (node.action) {
+          node.action();
+        }
+      }
+
+      if (node.started) {
+        if (node.is_motion) {
+          ez::exit_output exit = motion_wait.iterate();
+          node.finished = exit != ez::RUNNING;
+          if (node.finished) autonTimerMotionEnd(exit, motion_wait.settle_time_get());
+        } else if (node.done)
+          node.finished = node.done();
+        else
+          node.finished = now - node.start_time >= node.time;
+
+        if (node.finished && id == active_motion) active_motion = -1;
+      }
+
+      if (!node.finished) all_finished = false;
+    }
+
+    if (all_finished) return true;
+
+    if (now - start >= timeout) {
+      for (auto& node : nodes) {
+        if (!node.finished) printf("Action graph timed out waiting on %s\n", node.name.c_str());
+      }
+      return false;
+    }
+
+    pros::Task::delay_until(&next_wake, ez::util::DELAY_TIME);
+  }
+}
@@ -0,0 +1,166 @@
+#include "auton_timer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "pros/rtos.hpp"
+
+struct AutonStep {
+  std::string name;
+  int start;
+  int end;
+  ez::exit_output exit;
+  int settle;
+  bool motion;
+};
+
+static pros::Mutex autonTimerMutex;
+static std::vector<AutonStep> autonSteps;
+static bool autonTiming = false;
+static int autonStart = 0;
+static int autonBudget = 15000;
+static int autonMotion = -1;  // Index of the motion that's running
+
+static const char* exitName(ez::exit_output exit) {
+  switch (exit) {
+    case ez::RUNNING:
+      return "cut off";
+    case ez::SMALL_EXIT:
+      return "small";
+    case ez::BIG_EXIT:
+      return "big";
+    case ez::VELOCITY_EXIT:
+      return "velocity";
+    case ez::mA_EXIT:
+      return "mA";
+    case ez::ERROR_NO_CONSTANTS:
+      return "no constants";
+  }
+  return "";
+}
+
+static int autonNow() {
+  return pros::millis() - autonStart;
+}
+
+void autonTimerStart(int budget) {
+  autonTimerMutex.take();
+  autonSteps.clear();
+  autonSteps.reserve(256);
+  autonStart = pros::millis();
+  autonBudget = budget;
+  autonMotion = -1;
+  autonTiming = true;
+  autonTimerMutex.give();
+}
+
+void autonTimerBudgetSet(int budget) {
+  autonTimerMutex.take();
+  autonBudget = budget;
+  autonTimerMutex.give();
+}
+
+int autonTimerRemaining() {
+  autonTimerMutex.take();
+  int remaining = autonTiming ? std::max(0, autonBudget - autonNow()) : autonBudget;
+  autonTimerMutex.give();
+  return remaining;
+}
+
+// Ends the running motion, call with the mutex taken
+static void motionEnd(ez::exit_output exit, int settle) {
+  if (autonMotion == -1) return;
+  AutonStep& step = autonSteps[autonMotion];
+  step.end = autonNow();
+  step.exit = exit;
+  step.settle = settle;
+  autonMotion = -1;
+}
+
+void autonTimerMotion(std::string name) {
+  autonTimerMutex.take();
+  if (autonTiming) {
+    motionEnd(ez::RUNNING, 0);
+    int now = autonNow();
+    autonSteps.push_back({name, now, now, ez::RUNNING, 0, true});
+    autonMotion = autonSteps.size() - 1;
+  }
+  autonTimerMutex.give();
+}
+
+void autonTimerMotionEnd(ez::exit_output exit, int settle) {
+  autonTimerMutex.take();
+  if (autonTiming) motionEnd(exit, settle);
+  autonTimerMutex.give();
+}
+
+void autonTimerEvent(std::string name) {
+  autonTimerMutex.take();
+  if (autonTiming) {
+    int now = autonNow();
+    autonSteps.push_back({name, now, now, ez::RUNNING, 0, false});
+  }
+  autonTimerMutex.give();
+}
+
+static void autonTimerWrite(FILE* file, std::vector<AutonStep>& steps, int total, int budget) {
+  // Time with no motion running is spent waiting on delays, add it as its own steps
+  int moving = 0, settling = 0, waiting = 0;
+  int last_end = 0;
+  std::vector<AutonStep> sorted;
+  for (auto& step : steps) {
+    if (!step.motion) continue;
+    if (step.start > last_end) {
+      sorted.push_back({"waiting before " + step.name, last_end, step.start, ez::RUNNING, 0, false});
+      waiting += step.start - last_end;
+    }
+    sorted.push_back(step);
+    moving += step.end - step.start;
+    settling += step.settle;
+    last_end = std::max(last_end, step.end);
+  }
+  if (total > last_end) {
+    sorted.push_back({"waiting at the end", last_end, total, ez::RUNNING, 0, false});
+    waiting += total - last_end;
+  }
+
+  fprintf(file, "\nAuton took %.2fs of %.2fs, %.2fs of slack\n", total / 1000.0, budget / 1000.0, (budget - total) / 1000.0);
+  fprintf(file, "moving %.2fs (settling %.2fs), waiting %.2fs\n", moving / 1000.0, settling / 1000.0, waiting / 1000.0);
+
+  fprintf(file, "\nIn order\n%7s %7s %7s %7s  %-8s %s\n", "start", "end", "time", "settle", "exit", "step");
+  for (auto& step : steps) {
+    if (step.motion)
+      fprintf(file, "%7.2f %7.2f %7.2f %7.2f  %-8s %s\n", step.start / 1000.0, step.end / 1000.0, (step.end - step.start) / 1000.0, step.settle / 1000.0, exitName(step.exit), step.name.c_str());
+    else
+      fprintf(file, "%7.2f %7s %7s %7s  %-8s %s\n", step.start / 1000.0, "", "", "", "", step.name.c_str());
+  }
+
+  std::stable_sort(sorted.begin(), sorted.end(), [](const AutonStep& a, const AutonStep& b) { return a.end - a.start > b.end - b.start; });
+  fprintf(file, "\nLongest first\n%7s %7s  %s\n", "time", "settle", "step");
+  for (auto& step : sorted) {
+    fprintf(file, "%7.2f %7.2f  %s\n", (step.end - step.start) / 1000.0, step.settle / 1000.0, step.name.c_str());
+  }
+}
+
+void autonTimerReport() {
+  autonTimerMutex.take();
+  if (!autonTiming) {
+    autonTimerMutex.give();
+    return;
+  }
+  motionEnd(ez::RUNNING, 0);
+  autonTiming = false;
+  std::vector<AutonStep> steps = autonSteps;
+  int total = autonNow();
+  int budget = autonBudget;
+  autonTimerMutex.give();
+
+  autonTimerWrite(stdout, steps, total, budget);
+
+  if (!ez::util::SD_CARD_ACTIVE) return;
+  FILE* file = fopen("/usd/auton_timing.txt", "w");
+  if (!file) return;
+  autonTimerWrite(file, steps, total, budget);
+  fclose(file);
+}
@@ -31,12 +31,22 @@ void default_constants() {
   chassis.slew_drive_constants_set(7_in, 80);
 }
 
+// Curves for odomPathSet(splineGet("name"), speed), poses are x, y and heading
+// from where the auton starts.  Loaded from the SD card at startup, see spline.hpp
+void autonSplines() {
+  // splineAdd("ring rush", {{0, 0, 0}, {-10, 30, -20}, {-24, 44, -90}});
+}
+
 
 // . . .
 // Make your own autonomous functions here!
 // . . .
 
-void skills(){
+// Skills is broken into checkpoints so it can be started part way through,
+// see CheckpointRoute in checkpoint.hpp
+
+// scores alliance stake, puts everything down and clamps the first mogo
+void skillsAllianceStake(){
   // i hate vex
   
   // hopefully scores alliance stake and puts everything down
@@ -48,175 +58,224 @@ void skills(){
   unclampMogo();
   lift.move_absolute(0, 127);
 
-  chassis.pid_drive_set(-12_in, DRIVE_SPEED, true);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-90_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-28_in, 50);
+  driveSet(-12_in, DRIVE_SPEED, true);
+  pidWait();
+  turnSet(-90_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-28_in, 50);
   pros::delay(400);
   clampMogo();
-  chassis.pid_wait();
+  pidWait();
+}
 
+// fills the first mogo
+void skillsFirstMogoRings(){
   intakeOn();
-  chassis.pid_turn_set(-180_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(24_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-270_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(26_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-0_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(52_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(135_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(18_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  turnSet(-180_deg, TURN_SPEED);
+  pidWait();
+  driveSet(24_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(-270_deg, TURN_SPEED);
+  pidWait();
+  driveSet(26_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(-0_deg, TURN_SPEED);
+  pidWait();
+  driveSet(52_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(135_deg, TURN_SPEED);
+  pidWait();
+  driveSet(18_in, DRIVE_SPEED);
+  pidWait();
   intakeOff();
+}
 
-  chassis.pid_turn_set(90_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-12_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-135_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-38_in, DRIVE_SPEED);
-  chassis.pid_wait();
+// drops the first mogo in the corner
+void skillsFirstCorner(){
+  turnSet(90_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-12_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(-135_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-38_in, DRIVE_SPEED);
+  pidWait();
   unclampMogo();
-  chassis.pid_drive_set(38_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(38_in, DRIVE_SPEED);
+  pidWait();
+}
 
-  chassis.pid_turn_set(90_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-66_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-12_in, 50);
+// drives across and clamps the second mogo
+void skillsSecondMogo(){
+  turnSet(90_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-66_in, DRIVE_SPEED);
+  pidWait();
+  driveSet(-12_in, 50);
   pros::delay(400);
   clampMogo();
-  chassis.pid_wait();
+  pidWait();
+}
 
+// fills the second mogo
+void skillsSecondMogoRings(){
   intakeOn();
-  chassis.pid_turn_set(180_deg, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(24_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  turnSet(180_deg, DRIVE_SPEED);
+  pidWait();
+  driveSet(24_in, DRIVE_SPEED);
+  pidWait();
   
-  chassis.pid_turn_set(270_deg, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(24_in, DRIVE_SPEED);
-  chassis.pid_wait();
-
-  chassis.pid_turn_set(0_deg, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(38_in, DRIVE_SPEED);
-  chassis.pid_wait();
-
-  chassis.pid_turn_set(-135_deg, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(20_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  turnSet(270_deg, DRIVE_SPEED);
+  pidWait();
+  driveSet(24_in, DRIVE_SPEED);
+  pidWait();
+
+  turnSet(0_deg, DRIVE_SPEED);
+  pidWait();
+  driveSet(38_in, DRIVE_SPEED);
+  pidWait();
+
+  turnSet(-135_deg, DRIVE_SPEED);
+  pidWait();
+  driveSet(20_in, DRIVE_SPEED);
+  pidWait();
   intakeOff();
+}
 
-  chassis.pid_turn_set(-90_deg, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-12_in, DRIVE_SPEED);
-  chassis.pid_wait();
-
-  chassis.pid_turn_set(135_deg, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(38_in, DRIVE_SPEED);
-  chassis.pid_wait();
+// drops the second mogo in the corner
+void skillsSecondCorner(){
+  turnSet(-90_deg, DRIVE_SPEED);
+  pidWait();
+  driveSet(-12_in, DRIVE_SPEED);
+  pidWait();
+
+  turnSet(135_deg, DRIVE_SPEED);
+  pidWait();
+  driveSet(38_in, DRIVE_SPEED);
+  pidWait();
   unclampMogo();
+}
 
-  chassis.pid_drive_set(8_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(180_deg, DRIVE_SPEED);
-  chassis.pid_wait();
+// loads a ring and scores the first wall stake
+void skillsFirstWallStake(){
+  driveSet(8_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(180_deg, DRIVE_SPEED);
+  pidWait();
   intakeOn();
   liftLoad();
   
-  chassis.pid_drive_set(56_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-90_deg, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(56_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(-90_deg, DRIVE_SPEED);
+  pidWait();
   pros::delay(700);
   intakeOff();
 
   liftScore();
-  chassis.pid_drive_set(8_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-18_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(8_in, DRIVE_SPEED);
+  pidWait();
+  driveSet(-18_in, DRIVE_SPEED);
+  pidWait();
+}
 
+// loads a ring and scores the second wall stake
+void skillsSecondWallStake(){
   liftLoad();
-  chassis.pid_turn_set(-180_deg, TURN_SPEED);
-  chassis.pid_wait();
+  turnSet(-180_deg, TURN_SPEED);
+  pidWait();
   intakeOn();
-  chassis.pid_drive_set(26_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-26_in, DRIVE_SPEED);
+  driveSet(26_in, DRIVE_SPEED);
+  pidWait();
+  driveSet(-26_in, DRIVE_SPEED);
   pros::delay(700);
   intakeOff();
-  chassis.pid_wait();
-  chassis.pid_turn_set(-90_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(8_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  pidWait();
+  turnSet(-90_deg, TURN_SPEED);
+  pidWait();
+  driveSet(8_in, DRIVE_SPEED);
+  pidWait();
   liftScore();
-  chassis.pid_drive_set(6_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-18_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(6_in, DRIVE_SPEED);
+  pidWait();
+  driveSet(-18_in, DRIVE_SPEED);
+  pidWait();
   liftDown();
+}
 
-  chassis.pid_turn_set(-180_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(26_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(90_deg, TURN_SPEED);
-  chassis.pid_wait();
+// grabs a ring and clamps the third mogo
+void skillsThirdMogo(){
+  turnSet(-180_deg, TURN_SPEED);
+  pidWait();
+  driveSet(26_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(90_deg, TURN_SPEED);
+  pidWait();
   intakeOn();
-  chassis.pid_drive_set(34_in, DRIVE_SPEED);
+  driveSet(34_in, DRIVE_SPEED);
   pros::delay(500);
   intakeOff();
-  chassis.pid_turn_set(-30_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-26_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-8_in, 50);
+  turnSet(-30_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-26_in, DRIVE_SPEED);
+  pidWait();
+  driveSet(-8_in, 50);
   pros::delay(500);
   clampMogo();
-  chassis.pid_wait();
+  pidWait();
   intakeOn();
+}
 
-  chassis.pid_turn_set(45_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(35_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(90_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(42_in, 75);
-  chassis.pid_wait();
-  chassis.pid_turn_set(0_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-32_in, DRIVE_SPEED);
-  chassis.pid_wait();
+// fills the third mogo, puts it in the corner and pushes the last mogo in
+void skillsThirdCorner(){
+  // one curve to where the turn, drive, turn used to end up, lined up with the rings
+  odomPoseSet(75.5_in, -121.8_in, 90_deg, DRIVE_SPEED);
+  pidWait();
+  driveSet(42_in, 75);
+  pidWait();
+  turnSet(0_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-32_in, DRIVE_SPEED);
+  pidWait();
   unclampMogo();
-  chassis.pid_drive_set(5_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(5_in, DRIVE_SPEED);
+  pidWait();
   clampMogo();
-  chassis.pid_drive_set(-14_in, 80);
-  chassis.pid_wait();
-  chassis.pid_drive_set(4_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-90_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(144_in, 127);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-4_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(-14_in, 80);
+  pidWait();
+  driveSet(4_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(-90_deg, TURN_SPEED);
+  pidWait();
+  driveSet(144_in, 127);
+  pidWait();
+  driveSet(-4_in, DRIVE_SPEED);
+  pidWait();
+}
+
+// x and y are where each checkpoint should be from the start of the route,
+// put the robot there facing the heading before starting from it
+CheckpointRoute skillsRoute("SKILLS", {
+  //  name                   x       y       heading  clamped intake
+  {"alliance stake",         0.0,    0.0,    0,       false,  false, skillsAllianceStake},
+  {"first mogo rings",       28.0,   -12.0,  -90,     true,   false, skillsFirstMogoRings},
+  {"first corner",           66.7,   3.3,    135,     true,   false, skillsFirstCorner},
+  {"second mogo",            54.7,   3.3,    -135,    false,  false, skillsSecondMogo},
+  {"second mogo rings",      -23.3,  3.3,    90,      true,   false, skillsSecondMogoRings},
+  {"second corner",          -61.4,  3.1,    -135,    true,   false, skillsSecondCorner},
+  {"first wall stake",       -22.5,  -23.7,  135,     false,  false, skillsFirstWallStake},
+  {"second wall stake",      -6.9,   -85.4,  -90,     false,  false, skillsSecondWallStake},
+  {"third mogo",             -2.9,   -85.4,  -90,     false,  false, skillsThirdMogo},
+  {"third corner",           48.1,   -140.8, -30,     true,   true,  skillsThirdCorner},
+});
+
+void skills(){
+  autonTimerBudgetSet(60000);
+  skillsRoute.run();
+}
+
+std::vector<ez::Auton> skillsCheckpoints(){
+  return skillsRoute.autons();
 }
 
 void bluePositive(){
@@ -227,26 +286,25 @@ void bluePositive(){
 
   unclampMogo();
   intakeDown();
-  chassis.pid_drive_set(-14_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(30_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-10_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-16_in, 50);
-  pros::delay(1100);
-  clampMogo();
-  pros::delay(300);
+  driveSet(-14_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(30_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-10_in, DRIVE_SPEED);
+  pidWait();
+  driveSet(-16_in, 50);
+  markerDistance(-13_in, clampMogo);
+  pidWait();
 
   // after clamping mogo, turns to single stack to the left
   // turns intake on to score preload and drives to single stack
 
-  chassis.pid_turn_set(90_deg, TURN_SPEED);
+  turnSet(90_deg, TURN_SPEED);
   pros::delay(400);
   intakeOn();
   pros::delay(200);
-  chassis.pid_drive_set(29_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(29_in, DRIVE_SPEED);
+  pidWait();
   
   pros::delay(1000);
 
@@ -254,15 +312,15 @@ void bluePositive(){
   // turns to the upside down stack in front of the alliance stake
   // puts intake up and drives towards reverse stack and gets top ring
 
-  chassis.pid_drive_set(-29_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(-29_in, DRIVE_SPEED);
+  pidWait();
 
-  chassis.pid_turn_set(-45_deg, TURN_SPEED);
+  turnSet(-45_deg, TURN_SPEED);
   pros::delay(400);
   intakeUp();
   pros::delay(200);
-  chassis.pid_drive_set(35_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(35_in, DRIVE_SPEED);
+  pidWait();
 
   pros::delay(500);
 
@@ -270,17 +328,15 @@ void bluePositive(){
   // turns toward ladder
   // puts ladybrown mech up and drives into ladder with clamp side
 
-  chassis.pid_drive_set(-34_in, DRIVE_SPEED);
-  pros::delay(200);
-  intakeDown();
-  chassis.pid_wait();
+  driveSet(-34_in, DRIVE_SPEED);
+  markerDistance(-4_in, intakeDown);
+  pidWait();
 
-  chassis.pid_turn_set(45_deg, TURN_SPEED);
-  pros::delay(1200);
-  lift.move_absolute(700, 127);
-  pros::delay(250);
-  chassis.pid_drive_set(-25_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  turnSet(45_deg, TURN_SPEED);
+  markerAngle(0_deg, [](){ lift.move_absolute(700, 127); });
+  pidWait();
+  driveSet(-25_in, DRIVE_SPEED);
+  pidWait();
 
 }
 
@@ -289,168 +345,57 @@ void blueNegative(){
   // sets clamp up and intake down
   // drives forward, turns, and drives forward again
   // slows down right before mogo and then gets clamp on mogo
+  // each step starts off of what the robot is doing instead of a delay
 
+  ActionGraph graph;
 
   unclampMogo();
   intakeDown();
-  chassis.pid_drive_set(-9_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-30_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-17_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-8_in, 40);
-  pros::delay(400);
-  clampMogo();
-  chassis.pid_wait();
-  pros::delay(500);
+  int backUp = graph.motion("back up", [](){ driveSet(-9_in, DRIVE_SPEED); });
+  int faceMogo = graph.motion("face mogo", [](){ turnSet(-30_deg, TURN_SPEED); }, {backUp});
+  int toMogo = graph.motion("drive to mogo", [](){ driveSet(-17_in, DRIVE_SPEED); }, {faceMogo});
+  int slowToMogo = graph.motion("slow into mogo", [](){ driveSet(-8_in, 40); }, {toMogo});
+  int clamp = graph.add("clamp", clampMogo, {}, graph.during(slowToMogo, driveErrorBelow(3)));
 
   // turns after clamping mogo to go for the single stack first
   // after single stack it goes for the 2 stacks next to each other
   
 
-  chassis.pid_turn_set(-95_deg, 70);
-  intakeOn();
-  pros::delay(200);
-  chassis.pid_drive_set(19_in, DRIVE_SPEED);
-  pros::delay(1250);
+  int faceStack = graph.motion("face single stack", [](){ turnSet(-95_deg, 70); intakeOn(); }, {slowToMogo, clamp});
+  int toStack = graph.motion("drive to single stack", [](){ driveSet(19_in, DRIVE_SPEED); }, {}, graph.during(faceStack, headingPast(-80)));
 
   // left stack first
 
-  chassis.pid_turn_set(-181_deg, TURN_SPEED);
-  pros::delay(600);
-  chassis.pid_drive_set(16_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  pros::delay(500);
-  chassis.pid_drive_set(-6_in, DRIVE_SPEED);
-  pros::delay(550);
+  int faceLeft = graph.motion("face left stack", [](){ turnSet(-181_deg, TURN_SPEED); }, {}, graph.during(toStack, driveErrorBelow(3)));
+  int toLeft = graph.motion("drive to left stack", [](){ driveSet(16_in, DRIVE_SPEED); }, {}, graph.during(faceLeft, headingPast(-165)));
+  int intakeLeft = graph.wait("intake left stack", 500, {toLeft});
+  int backLeft = graph.motion("back off left stack", [](){ driveSet(-6_in, DRIVE_SPEED); }, {intakeLeft});
   
   // right stack second
 
-  chassis.pid_turn_relative_set(24.5_deg, TURN_SPEED);
-  pros::delay(400);
-  chassis.pid_drive_set(9.5_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  pros::delay(1000);
+  int faceRight = graph.motion("face right stack", [](){ turnRelativeSet(24.5_deg, TURN_SPEED); }, {}, graph.during(backLeft, driveErrorBelow(1.5)));
+  int toRight = graph.motion("drive to right stack", [](){ driveSet(9.5_in, DRIVE_SPEED); }, {}, graph.during(faceRight, turnErrorBelow(5)));
+  int intakeRight = graph.wait("intake right stack", 1000, {toRight});
 
   // moves back and swings to face ladder
   // puts ladybrown mech up and drives into ladder with clamp side
 
-  chassis.pid_drive_set(-12_in, DRIVE_SPEED);
-  pros::delay(550);
-  chassis.pid_swing_set(ez::RIGHT_SWING, -65_deg, SWING_SPEED, -30);
-  chassis.pid_wait();
-  lift.move_absolute(700, 127);
-  pros::delay(300);
-  chassis.pid_drive_set(-26_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  int backRight = graph.motion("back off right stack", [](){ driveSet(-12_in, DRIVE_SPEED); }, {intakeRight});
+  int faceLadder = graph.motion("face ladder", [](){ swingSet(ez::RIGHT_SWING, -65_deg, SWING_SPEED, -30); }, {}, graph.during(backRight, driveErrorBelow(2)));
+  int liftUp = graph.add("lift up", [](){ lift.move_absolute(700, 127); }, {faceLadder});
+  graph.motion("drive to ladder", [](){ driveSet(-26_in, DRIVE_SPEED); }, {liftUp}, [](){ return lift.get_position() > 500; });
+
+  graph.run();
 
 }
 
+// red runs the blue routines mirrored across the field
 void redNegative(){
-  unclampMogo();
-  intakeDown();
-  chassis.pid_drive_set(-9_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(30_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-17_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-8_in, 40);
-  pros::delay(400);
-  clampMogo();
-  chassis.pid_wait();
-  pros::delay(500);
-  chassis.pid_turn_set(95_deg, 70);
-  intakeOn();
-  pros::delay(200);
-  chassis.pid_drive_set(19_in, DRIVE_SPEED);
-  pros::delay(1250);
-  chassis.pid_turn_set(179_deg, TURN_SPEED);
-  pros::delay(600);
-  chassis.pid_drive_set(16_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  pros::delay(500);
-  chassis.pid_drive_set(-6_in, DRIVE_SPEED);
-  pros::delay(550);
-  
-  
-  chassis.pid_turn_relative_set(-24.5_deg, TURN_SPEED);
-  pros::delay(400);
-  chassis.pid_drive_set(9.5_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  pros::delay(1000);
-  chassis.pid_drive_set(-12_in, DRIVE_SPEED);
-  pros::delay(550);
-  chassis.pid_swing_set(ez::LEFT_SWING, 65_deg, SWING_SPEED, -30);
-  chassis.pid_wait();
-  lift.move_absolute(700, 127);
-  chassis.pid_drive_set(-26_in, DRIVE_SPEED);
+  runMirrored(blueNegative);
 }
 
 void redPositive(){
-
-  // sets clamp in up position and puts intake down
-  // drives forward, turns, drives forward
-  // slows down right before mogo and then gets mogo clamped
-
-  unclampMogo();
-  intakeDown();
-  chassis.pid_drive_set(-13_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-30_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-10_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-14_in, 40);
-  pros::delay(1100);
-  clampMogo();
-  pros::delay(300);
-
-  // after clamping mogo, turns to single stack to the left
-  // turns intake on to score preload and drives to single stack
-
-  chassis.pid_turn_set(-90_deg, TURN_SPEED);
-  pros::delay(400);
-  intakeOn();
-  pros::delay(200);
-  chassis.pid_drive_set(26_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  
-  pros::delay(1000);
-
-  // after single stack moves back to original mogo position
-  // turns to the upside down stack in front of the alliance stake
-  // puts intake up and drives towards reverse stack and gets top ring
-
-  chassis.pid_drive_set(-26_in, DRIVE_SPEED);
-  chassis.pid_wait();
-
-  chassis.pid_turn_set(45_deg, TURN_SPEED);
-  pros::delay(400);
-  intakeUp();
-  pros::delay(200);
-  chassis.pid_drive_set(35_in, DRIVE_SPEED);
-  chassis.pid_wait();
-
-  pros::delay(500);
-
-  // drives back to original mogo position
-  // turns toward ladder
-  // puts ladybrown mech up and drives into ladder with clamp side
-
-  chassis.pid_drive_set(-34_in, DRIVE_SPEED);
-  pros::delay(200);
-  intakeDown();
-  chassis.pid_wait();
-
-  chassis.pid_turn_set(-45_deg, TURN_SPEED);
-  pros::delay(1200);
-  lift.move_absolute(700, 127);
-  pros::delay(250);
-  chassis.pid_drive_set(-25_in, DRIVE_SPEED);
-  chassis.pid_wait();
-
+  runMirrored(bluePositive);
 }
 
 void redElimPositive(){
@@ -461,68 +406,68 @@ void redElimPositive(){
 
   unclampMogo();
   intakeDown();
-  chassis.pid_drive_set(-18_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-30_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-9_in, 60);
+  driveSet(-18_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(-30_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-9_in, 60);
   pros::delay(700);
   clampMogo();
   pros::delay(300);
 
   
 
-  chassis.pid_turn_set(-90_deg, TURN_SPEED);
+  turnSet(-90_deg, TURN_SPEED);
   pros::delay(400);
   intakeOn();
   pros::delay(200);
-  chassis.pid_drive_set(26_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(26_in, DRIVE_SPEED);
+  pidWait();
   
   pros::delay(1000);
 
   
 
-  chassis.pid_drive_set(-26_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(-26_in, DRIVE_SPEED);
+  pidWait();
 
-  chassis.pid_turn_set(45_deg, TURN_SPEED);
+  turnSet(45_deg, TURN_SPEED);
   pros::delay(400);
   intakeUp();
   pros::delay(200);
-  chassis.pid_drive_set(35_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(35_in, DRIVE_SPEED);
+  pidWait();
 
   pros::delay(500);
 
-  chassis.pid_drive_set(-10_in, DRIVE_SPEED);
+  driveSet(-10_in, DRIVE_SPEED);
   pros::delay(400);
   intakeDown();
-  chassis.pid_wait();
+  pidWait();
 
-  chassis.pid_swing_set(ez::RIGHT_SWING, -45_deg, SWING_SPEED, 0);
-  chassis.pid_wait();
+  swingSet(ez::RIGHT_SWING, -45_deg, SWING_SPEED, 0);
+  pidWait();
 
-  chassis.pid_drive_set(58_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(58_in, DRIVE_SPEED);
+  pidWait();
 
   doinker.set_value(1);
   pros::delay(300);
 
-  chassis.pid_turn_set(-225_deg, TURN_SPEED);
-  chassis.pid_wait();
+  turnSet(-225_deg, TURN_SPEED);
+  pidWait();
 
-  chassis.pid_drive_set(-15_in, DRIVE_SPEED);
+  driveSet(-15_in, DRIVE_SPEED);
   pros::delay(600);
   unclampMogo();
-  chassis.pid_wait();
+  pidWait();
 }
 
 void redElimNegative(){
-
+  runMirrored(blueElimNegative);
 }
 
-void blueElimPositive(){
+co::Task blueElimPositiveRoute(){
 
   // sets clamp in up position and puts intake down
   // drives forward, turns, drives forward
@@ -530,116 +475,97 @@ void blueElimPositive(){
 
   unclampMogo();
   intakeDown();
-  chassis.pid_drive_set(-14.5_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(30_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-10_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-14_in, 40);
-  pros::delay(1100);
+  co_await co::profile(bakedProfile("blue elim positive start"), true);  // 14.5in, see profiles.hpp
+  co_await co::turn(30_deg, TURN_SPEED);
+  co_await co::drive(-10_in, DRIVE_SPEED);
+  co_await co::whenAny(co::drive(-14_in, 40), co::until(driveErrorBelow(1.5)), co::delay(1100));
   clampMogo();
-  pros::delay(300);
+  co_await co::delay(300);
 
   // turns towards single stack
-  // turns intake on and drives into single stack
+  // turns intake on partway through the turn and drives into single stack
 
-  chassis.pid_turn_set(90_deg, TURN_SPEED);
-  pros::delay(400);
-  intakeOn();
-  pros::delay(200);
-  chassis.pid_drive_set(26_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  co_await co::whenAll(co::turn(90_deg, TURN_SPEED), co::after(co::until(headingPast(60)), intakeOn));
+  co_await co::drive(26_in, DRIVE_SPEED);
   
-  pros::delay(1000);
+  co_await co::delay(1000);
 
   // moves back to original mogo position
   // turns towards reverse stack infront of alliance stake
   // puts intake up and grabs top ring from reverse stake
 
-  chassis.pid_drive_set(-26_in, DRIVE_SPEED);
-  chassis.pid_wait();
-
-  chassis.pid_turn_set(-45_deg, TURN_SPEED);
-  pros::delay(400);
-  intakeUp();
-  pros::delay(200);
-  chassis.pid_drive_set(35_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  co_await co::drive(-26_in, DRIVE_SPEED);
+  co_await co::whenAll(co::turn(-45_deg, TURN_SPEED), co::after(co::until(headingPast(0)), intakeUp));
+  co_await co::drive(35_in, DRIVE_SPEED);
 
-  pros::delay(500);
+  co_await co::delay(500);
 
   // moves back to original mogo position
+  // drops the intake once it's clear of the stack
   // turns towards positive corner
   // drives to positive corner
 
-  chassis.pid_drive_set(-35_in, DRIVE_SPEED);
-  pros::delay(400);
-  intakeDown();
-  chassis.pid_wait();
-
-  chassis.pid_turn_set(45_deg, TURN_SPEED);
-  pros::delay(500);
-  chassis.pid_drive_set(70_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  co_await co::whenAll(co::drive(-35_in, DRIVE_SPEED), co::after(co::until(driveErrorBelow(25)), intakeDown));
+  co_await co::turn(45_deg, TURN_SPEED);
+  co_await co::drive(70_in, DRIVE_SPEED);
 
   // puts doinker down
   // spins to remove rings
   // faces clamp side tangent to positive corner
   // drops mogo and moves forward to get out the way
 
-  doinker.set_value(1);
-  pros::delay(200);
-  chassis.pid_turn_set(225_deg, TURN_SPEED);
-  pros::delay(800);
-  unclampMogo();
-  pros::delay(200);
-  chassis.pid_drive_set(10_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  doinkerSet(true);
+  co_await co::delay(200);
+  co_await co::whenAll(co::turn(225_deg, TURN_SPEED), co::after(co::until(headingPast(180)), unclampMogo));
+  co_await co::drive(10_in, DRIVE_SPEED);
+
+}
 
+void blueElimPositive(){
+  co::run(blueElimPositiveRoute());
 }
 
 void blueElimNegative(){
   unclampMogo();
   intakeDown();
-  chassis.pid_drive_set(-9_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_turn_set(-30_deg, TURN_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-17_in, DRIVE_SPEED);
-  chassis.pid_wait();
-  chassis.pid_drive_set(-8_in, 40);
+  driveSet(-9_in, DRIVE_SPEED);
+  pidWait();
+  turnSet(-30_deg, TURN_SPEED);
+  pidWait();
+  driveSet(-17_in, DRIVE_SPEED);
+  pidWait();
+  driveSet(-8_in, 40);
   pros::delay(400);
   clampMogo();
-  chassis.pid_wait();
+  pidWait();
   pros::delay(500);
-  chassis.pid_turn_set(-95_deg, 70);
+  turnSet(-95_deg, 70);
   intakeOn();
   pros::delay(200);
-  chassis.pid_drive_set(19_in, DRIVE_SPEED);
+  driveSet(19_in, DRIVE_SPEED);
   pros::delay(1250);
-  chassis.pid_turn_set(-181_deg, TURN_SPEED);
+  turnSet(-181_deg, TURN_SPEED);
   pros::delay(600);
-  chassis.pid_drive_set(16_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(16_in, DRIVE_SPEED);
+  pidWait();
   pros::delay(500);
-  chassis.pid_drive_set(-6_in, DRIVE_SPEED);
+  driveSet(-6_in, DRIVE_SPEED);
   pros::delay(550);
   
   
-  chassis.pid_turn_relative_set(24.5_deg, TURN_SPEED);
+  turnRelativeSet(24.5_deg, TURN_SPEED);
   pros::delay(400);
-  chassis.pid_drive_set(9.5_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(9.5_in, DRIVE_SPEED);
+  pidWait();
   pros::delay(1000);
-  chassis.pid_drive_set(-12_in, DRIVE_SPEED);
+  driveSet(-12_in, DRIVE_SPEED);
   pros::delay(550);
-  chassis.pid_swing_set(ez::RIGHT_SWING, -65_deg, SWING_SPEED, -30);
-  chassis.pid_wait();
+  swingSet(ez::RIGHT_SWING, -65_deg, SWING_SPEED, -30);
+  pidWait();
   lift.move_absolute(700, 127);
   pros::delay(300);
-  chassis.pid_drive_set(-26_in, DRIVE_SPEED);
-  chassis.pid_wait();
+  driveSet(-26_in, DRIVE_SPEED);
+  pidWait();
 }
 
  /* void bluePositiveNew(){
@@ -650,7 +576,7 @@ void blueElimNegative(){
   bottomIntakeOnly();
   chassis.pid_wait();
   
-  chassis.pid_turn_set(-90_deg, TURN_SPEED);
+  turnSet(-90_deg, TURN_SPEED);
   chassis.pid_wait();
   chassis.pid_drive_set(-26_in, DRIVE_SPEED);
   chassis.pid_wait_until(-22_in);
@@ -1,8 +1,8 @@
 #include "main.h"
 #include "pros/misc.h"
 
-void autonTestor(){
-    if(master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_UP)){
+void autonTestor(InputReader& input){
+    if(input.pressed(pros::E_CONTROLLER_DIGITAL_UP)){
         autonomous();
     }
-}
\ No newline at end of file
+}
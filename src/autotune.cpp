@@ -0,0 +1,264 @@
+#include "main.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+// Relay output, out of 127, and how far past the target the IMU has to go before it flips
+const int AUTOTUNE_RELAY_POWER = 50;
+const double AUTOTUNE_HYSTERESIS = 1.0;
+// Flips to let the rocking settle into a steady cycle, then cycles to measure
+const int AUTOTUNE_SKIP_FLIPS = 4;
+const int AUTOTUNE_CYCLES = 6;
+const int AUTOTUNE_TIMEOUT = 10000;
+// Test turns with the same speed autons use, and the most they can overshoot
+const int AUTOTUNE_SPEED = 90;
+const double AUTOTUNE_MAX_OVERSHOOT = 3.0;
+// A test turn that takes longer than this, or swings back across the target, fails
+const int AUTOTUNE_TURN_TIMEOUT = 3000;
+const int AUTOTUNE_MAX_CROSSINGS = 1;
+// How far past the target counts as crossing it, so IMU noise while settling doesn't
+const double AUTOTUNE_CROSSING_BAND = 0.5;
+
+const char* AUTOTUNE_PATH = "/usd/autotune.txt";
+
+// Scales from the ultimate gain and period to kp, Ti and Td, Ti of 0 is no i
+struct AutotuneRule {
+  const char* name;
+  double kp;
+  double ti;
+  double td;
+};
+
+const AutotuneRule AUTOTUNE_RULES[] = {
+    {"PD", 0.8, 0, 0.125},
+    {"some overshoot", 0.33, 0.5, 0.33},
+    {"no overshoot", 0.2, 0.5, 0.33},
+};
+
+static const char* autotuneName(autotune_motion motion) {
+  return motion == AUTOTUNE_TURN ? "turn" : "swing";
+}
+
+static ez::PID::Constants autotuneConstantsGet(autotune_motion motion) {
+  return motion == AUTOTUNE_TURN ? chassis.turnPID.constants : chassis.swingPID.constants;
+}
+
+static void autotuneConstantsSet(autotune_motion motion, ez::PID::Constants constants) {
+  if (motion == AUTOTUNE_TURN)
+    chassis.pid_turn_constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+  else
+    chassis.pid_swing_constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+}
+
+// Rocks the robot around its heading, returns false if it never settled into a cycle
+static bool autotuneRelay(autotune_motion motion, double& ultimate_gain, double& ultimate_period) {
+  chassis.drive_mode_set(ez::DISABLE);  // Stops EZ's PID task from driving while the relay does
+
+  double target = chassis.drive_imu_get();
+  int output = AUTOTUNE_RELAY_POWER;
+  int flips = 0, cycles = 0;
+  int cycle_start = 0;
+  double high = target, low = target;
+  double amplitude_total = 0;
+  int period_total = 0;
+
+  int start = pros::millis();
+  std::uint32_t now = start;
+  while (cycles < AUTOTUNE_CYCLES && (int)now - start < AUTOTUNE_TIMEOUT) {
+    double heading = chassis.drive_imu_get();
+    double error = target - heading;
+    high = std::max(high, heading);
+    low = std::min(low, heading);
+
+    // Only flip once the heading is past the hysteresis, so IMU noise can't chatter the relay
+    int next = output;
+    if (error > AUTOTUNE_HYSTERESIS) next = AUTOTUNE_RELAY_POWER;
+    if (error < -AUTOTUNE_HYSTERESIS) next = -AUTOTUNE_RELAY_POWER;
+    if (next != output) {
+      output = next;
+      flips++;
+      // A cycle goes from one flip to positive to the next
+      if (output > 0 && flips > AUTOTUNE_SKIP_FLIPS) {
+        if (cycle_start != 0) {
+          amplitude_total += (high - low) / 2.0;
+          period_total += now - cycle_start;
+          cycles++;
+        }
+        cycle_start = now;
+        high = low = heading;
+      }
+    }
+
+    if (motion == AUTOTUNE_TURN)
+      chassis.drive_set(output, -output);
+    else
+      chassis.drive_set(output, 0);
+    pros::Task::delay_until(&now, ez::util::DELAY_TIME);
+  }
+  chassis.drive_set(0, 0);
+
+  if (cycles < AUTOTUNE_CYCLES) return false;
+  double amplitude = amplitude_total / cycles;
+  if (amplitude <= AUTOTUNE_HYSTERESIS) return false;
+
+  // Describing function of a relay with hysteresis
+  ultimate_gain = 4.0 * AUTOTUNE_RELAY_POWER / (M_PI * std::sqrt(amplitude * amplitude - AUTOTUNE_HYSTERESIS * AUTOTUNE_HYSTERESIS));
+  ultimate_period = period_total / 1000.0 / cycles;
+  return true;
+}
+
+// Turns to each test heading, returns the total time or -1 if a turn overshot or got stuck
+static double autotuneTest(autotune_motion motion, ez::PID::Constants constants, double& worst_overshoot) {
+  autotuneConstantsSet(motion, constants);
+  const double targets[] = {90, -90, 45, -45};
+  int start = pros::millis();
+  worst_overshoot = 0;
+  bool failed = false;
+
+  MotionWait wait;
+  for (double target : targets) {
+    double from = chassis.headingPID.target_get();
+    if (motion == AUTOTUNE_TURN)
+      chassis.pid_turn_relative_set(target, AUTOTUNE_SPEED);
+    else
+      chassis.pid_swing_relative_set(ez::LEFT_SWING, target, AUTOTUNE_SPEED);
+    wait.reset();
+
+    ez::exit_output exit = ez::RUNNING;
+    int turn_start = pros::millis();
+    int side = -1;  // Short of the target, 1 past it
+    int crossings = 0;
+    while (exit == ez::RUNNING) {
+      double overshoot = (chassis.drive_imu_get() - from - target) * ez::util::sgn(target);
+      worst_overshoot = std::max(worst_overshoot, overshoot);
+      if (overshoot * side < -AUTOTUNE_CROSSING_BAND) {
+        side = -side;
+        crossings++;
+      }
+      // Still rocking back and forth, it may never settle
+      if (crossings > AUTOTUNE_MAX_CROSSINGS || (int)pros::millis() - turn_start > AUTOTUNE_TURN_TIMEOUT) {
+        failed = true;
+        break;
+      }
+      exit = wait.iterate();
+      pros::delay(ez::util::DELAY_TIME);
+    }
+    if (exit == ez::mA_EXIT || exit == ez::VELOCITY_EXIT) failed = true;
+    if (failed) break;
+  }
+
+  // Don't leave a failed candidate rocking the robot
+  if (failed) {
+    chassis.drive_mode_set(ez::DISABLE);
+    chassis.drive_set(0, 0);
+  }
+
+  if (failed || worst_overshoot > AUTOTUNE_MAX_OVERSHOOT) return -1;
+  return (pros::millis() - start) / 1000.0;
+}
+
+static void autotunePrint(const char* name, ez::PID::Constants constants, double time, double overshoot) {
+  printf("%-16s kp %6.3g ki %6.3g kd %6.3g  ", name, constants.kp, constants.ki, constants.kd);
+  if (time < 0)
+    printf("failed, overshoot %.1fdeg\n", overshoot);
+  else
+    printf("%.2fs, overshoot %.1fdeg\n", time, overshoot);
+}
+
+// Returns false if there's no SD card to save to
+static bool autotuneSave(autotune_motion motion, ez::PID::Constants constants) {
+  if (!ez::util::SD_CARD_ACTIVE) return false;
+
+  // Keep whatever the other motion saved
+  std::map<std::string, ez::PID::Constants> saved;
+  FILE* file = fopen(AUTOTUNE_PATH, "r");
+  if (file) {
+    char name[16];
+    ez::PID::Constants line;
+    while (fscanf(file, "%15s %lf %lf %lf %lf", name, &line.kp, &line.ki, &line.kd, &line.start_i) == 5) saved[name] = line;
+    fclose(file);
+  }
+  saved[autotuneName(motion)] = constants;
+
+  file = fopen(AUTOTUNE_PATH, "w");
+  if (!file) return false;
+  for (auto& line : saved) {
+    fprintf(file, "%s %g %g %g %g\n", line.first.c_str(), line.second.kp, line.second.ki, line.second.kd, line.second.start_i);
+  }
+  fclose(file);
+  return true;
+}
+
+void autotuneRun(autotune_motion motion) {
+  const char* name = autotuneName(motion);
+  executor.mode_set(RUN_AUTONOMOUS);  // Stops driver control from fighting the relay
+  // A macro the chord set off would otherwise be frozen wherever it was for the whole tune
+  intakeStop();
+  liftScoreCancel();
+  lift.brake();
+  chassis.pid_targets_reset();
+  odomImuReset();
+  odomSensorsReset();
+  chassis.drive_brake_set(MOTOR_BRAKE_HOLD);
+
+  double ultimate_gain, ultimate_period;
+  printf("\nAutotune %s: relay at %i power\n", name, AUTOTUNE_RELAY_POWER);
+  if (!autotuneRelay(motion, ultimate_gain, ultimate_period)) {
+    printf("Autotune %s: the robot never rocked back and forth evenly, nothing changed\n", name);
+    ez::screen_print("autotune failed", 7);
+    return;
+  }
+  printf("Ultimate gain %.2f, ultimate period %.3fs\n", ultimate_gain, ultimate_period);
+
+  // EZ's PID adds up i and takes d once per loop, not per second
+  double dt = ez::util::DELAY_TIME / 1000.0;
+  ez::PID::Constants current = autotuneConstantsGet(motion);
+  ez::PID::Constants best = current;
+  double overshoot;
+  double best_time = autotuneTest(motion, current, overshoot);
+  autotunePrint("current", current, best_time, overshoot);
+
+  for (auto& rule : AUTOTUNE_RULES) {
+    ez::PID::Constants candidate;
+    candidate.kp = rule.kp * ultimate_gain;
+    candidate.ki = rule.ti > 0 ? candidate.kp / (rule.ti * ultimate_period) * dt : 0;
+    candidate.kd = candidate.kp * rule.td * ultimate_period / dt;
+    candidate.start_i = current.start_i;
+
+    double time = autotuneTest(motion, candidate, overshoot);
+    autotunePrint(rule.name, candidate, time, overshoot);
+    if (time >= 0 && (best_time < 0 || time < best_time)) {
+      best_time = time;
+      best = candidate;
+    }
+  }
+
+  autotuneConstantsSet(motion, best);
+  chassis.drive_mode_set(ez::DISABLE);
+  if (best.kp == current.kp && best.ki == current.ki && best.kd == current.kd) {
+    printf("Autotune %s: nothing beat the current constants\n", name);
+    ez::screen_print("autotune kept current", 7);
+    return;
+  }
+
+  if (autotuneSave(motion, best))
+    printf("Autotune %s: saved to %s, to make it permanent put this in default_constants()\n", name, AUTOTUNE_PATH);
+  else
+    printf("Autotune %s: no SD card, this only lasts until the program restarts unless it goes in default_constants()\n", name);
+  printf("  chassis.pid_%s_constants_set(%.3g, %.3g, %.3g, %.3g);\n", name, best.kp, best.ki, best.kd, best.start_i);
+  ez::screen_print(std::string("autotune ") + name + " saved", 7);
+}
+
+void autotuneLoad() {
+  FILE* file = ez::util::SD_CARD_ACTIVE ? fopen(AUTOTUNE_PATH, "r") : nullptr;
+  if (!file) return;
+  char name[16];
+  ez::PID::Constants constants;
+  while (fscanf(file, "%15s %lf %lf %lf %lf", name, &constants.kp, &constants.ki, &constants.kd, &constants.start_i) == 5) {
+    if (!strcmp(name, "turn")) autotuneConstantsSet(AUTOTUNE_TURN, constants);
+    if (!strcmp(name, "swing")) autotuneConstantsSet(AUTOTUNE_SWING, constants);
+  }
+  fclose(file);
+}
@@ -0,0 +1,57 @@
+#include "cached_out.hpp"
+
+#include <cstdio>
+
+std::vector<CachedDigitalOut*>& CachedDigitalOut::all() {
+  // Function static so it exists before any inline outputs are constructed
+  static std::vector<CachedDigitalOut*> outputs;
+  return outputs;
+}
+
+CachedDigitalOut::CachedDigitalOut(std::uint8_t port, bool init_state)
+    : output(std::in_place, port, init_state), port(port), target(init_state), written(init_state) {
+  all().push_back(this);
+}
+
+CachedDigitalOut::CachedDigitalOut(ez::Piston& piston)
+    : piston(&piston), target(piston.get()), written(piston.get()) {
+  all().push_back(this);
+}
+
+void CachedDigitalOut::set_value(bool value) {
+  requests++;
+  target = value;
+}
+
+bool CachedDigitalOut::get_value() { return target; }
+
+void CachedDigitalOut::flush() {
+  bool value = target;
+  if (value == written) return;
+
+  if (piston)
+    piston->set(value);
+  else
+    output->set_value(value);
+  written = value;
+  writes++;
+}
+
+int CachedDigitalOut::writes_get() { return writes; }
+
+int CachedDigitalOut::suppressed_get() { return requests - writes; }
+
+void CachedDigitalOut::flush_all() {
+  for (auto output : all()) {
+    output->flush();
+  }
+}
+
+void CachedDigitalOut::stats_print() {
+  for (auto output : all()) {
+    if (output->piston)
+      printf("piston: %i writes, %i suppressed\n", output->writes_get(), output->suppressed_get());
+    else
+      printf("adi port %i: %i writes, %i suppressed\n", output->port, output->writes_get(), output->suppressed_get());
+  }
+}
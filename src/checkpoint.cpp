@@ -0,0 +1,77 @@
+#include "main.h"
+
+#include <cstdio>
+#include <map>
+
+CheckpointRoute::CheckpointRoute(std::string name, std::vector<Checkpoint> checkpoints) : name(name), checkpoints(checkpoints) {}
+
+// Puts the robot's sensors and mechanisms how they'd be at this checkpoint
+void CheckpointRoute::setup(Checkpoint& checkpoint) {
+  driveAngleSet(checkpoint.heading * okapi::degree);
+  odomSet({checkpoint.x, checkpoint.y, checkpoint.heading});
+  if (checkpoint.clamped)
+    clampMogo();
+  else
+    unclampMogo();
+  if (checkpoint.intake)
+    intakeOn();
+  else
+    intakeOff();
+  intakeDown();
+  doinkerSet(false);
+  liftDown();
+  printf("%s from %s, (%.1f, %.1f) at %.0f deg\n", name.c_str(), checkpoint.name.c_str(), checkpoint.x, checkpoint.y, checkpoint.heading);
+}
+
+void CheckpointRoute::run(int from) {
+  if (from > 0) setup(checkpoints[from]);
+
+  std::map<std::string, int> best = bestLoad();
+  printf("\n%s checkpoint times\n", name.c_str());
+  for (int i = from; i < (int)checkpoints.size(); i++) {
+    int start = pros::millis();
+    checkpoints[i].run();
+    record(checkpoints[i], pros::millis() - start, best);
+  }
+}
+
+std::string CheckpointRoute::path() {
+  return "/usd/" + name + "_times.csv";
+}
+
+std::map<std::string, int> CheckpointRoute::bestLoad() {
+  std::map<std::string, int> best;
+  FILE* file = ez::util::SD_CARD_ACTIVE ? fopen(path().c_str(), "r") : nullptr;
+  if (!file) return best;
+  char line[96];
+  while (fgets(line, sizeof(line), file)) {
+    char checkpoint[64];
+    int time;
+    if (sscanf(line, "%63[^,],%i", checkpoint, &time) != 2) continue;
+    if (!best.count(checkpoint) || time < best[checkpoint]) best[checkpoint] = time;
+  }
+  fclose(file);
+  return best;
+}
+
+void CheckpointRoute::record(Checkpoint& checkpoint, int time, std::map<std::string, int>& best) {
+  if (best.count(checkpoint.name))
+    printf("%-24s %6.2fs  best %6.2fs\n", checkpoint.name.c_str(), time / 1000.0, best[checkpoint.name] / 1000.0);
+  else
+    printf("%-24s %6.2fs\n", checkpoint.name.c_str(), time / 1000.0);
+
+  // Written as each piece finishes, so a run that's stopped partway keeps what it got through
+  if (!ez::util::SD_CARD_ACTIVE) return;
+  FILE* file = fopen(path().c_str(), "a");
+  if (!file) return;
+  fprintf(file, "%s,%i\n", checkpoint.name.c_str(), time);
+  fclose(file);
+}
+
+std::vector<ez::Auton> CheckpointRoute::autons() {
+  std::vector<ez::Auton> autons;
+  for (int i = 1; i < (int)checkpoints.size(); i++) {
+    autons.push_back(ez::Auton(name + " from " + checkpoints[i].name, [this, i]() { run(i); }));
+  }
+  return autons;
+}
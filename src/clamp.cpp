@@ -1,21 +1,29 @@
 #include "main.h"
 
-bool state = true;
-
-void clampControl(){
-    if(master.get_digital_new_press(DIGITAL_L2)){
-        state = !state;
+// the pistons boot low (clamped), so go by what was last written instead of a flag of our own
+void clampToggle(){
+    if (clamp1.get_value()) {
+        clampMogo();
+    } else {
+        unclampMogo();
     }
-    clamp1.set_value(state);
-    clamp2.set_value(state);
+}
+
+InputReader clampInput;
+
+bool clampPressed(){
+    clampInput.update();
+    return clampInput.pressed(DIGITAL_L2);
 }
 
 void clampMogo(){
+    autonTimerEvent("clampMogo");
     clamp1.set_value(0);
     clamp2.set_value(0);
 }
 
 void unclampMogo(){
+    autonTimerEvent("unclampMogo");
     clamp1.set_value(1);
     clamp2.set_value(1);
-}
\ No newline at end of file
+}
@@ -0,0 +1,186 @@
+#include "coro.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <new>
+
+#include "auton_timer.hpp"
+
+namespace co {
+
+// Fixed pools of coroutine frames, small ones for helpers like wrap() and
+// after() and big ones for whole autons
+template <std::size_t Size, int Count>
+struct FramePool {
+  alignas(std::max_align_t) unsigned char frames[Count][Size];
+  bool used[Count] = {};
+
+  void* alloc(std::size_t size) {
+    if (size > Size) return nullptr;
+    for (int i = 0; i < Count; i++) {
+      if (!used[i]) {
+        used[i] = true;
+        return frames[i];
+      }
+    }
+    return nullptr;
+  }
+
+  bool free(void* frame) {
+    if (frame < (void*)frames || frame >= (void*)(frames + Count)) return false;
+    used[((unsigned char*)frame - frames[0]) / Size] = false;
+    return true;
+  }
+
+  // Frees everything except keep
+  void reset(void* keep) {
+    for (int i = 0; i < Count; i++) used[i] = frames[i] == keep;
+  }
+};
+
+static FramePool<256, 32> smallFrames;
+static FramePool<1024, 16> mediumFrames;
+static FramePool<8192, 4> largeFrames;
+static int heapFrames = 0;
+
+void* frameAlloc(std::size_t size) {
+  if (void* frame = smallFrames.alloc(size)) return frame;
+  if (void* frame = mediumFrames.alloc(size)) return frame;
+  if (void* frame = largeFrames.alloc(size)) return frame;
+
+  // Shouldn't happen, but it's better to run the auton than to stop
+  heapFrames++;
+  printf("Coroutine frame of %i bytes didn't fit in the pools, %i on the heap\n", (int)size, heapFrames);
+  return ::operator new(size);
+}
+
+void frameFree(void* frame, std::size_t size) {
+  if (smallFrames.free(frame) || mediumFrames.free(frame) || largeFrames.free(frame)) return;
+  heapFrames--;
+  ::operator delete(frame);
+}
+
+// Waiting at once before the table grows onto the heap
+const int MAX_WAITERS = 32;
+static Waiter* fixedWaiters[MAX_WAITERS];
+static Waiter** waiters = fixedWaiters;
+static int waiterCapacity = MAX_WAITERS;
+static int waiterCount = 0;
+static unsigned tickCount = 0;
+
+static bool running = false;
+
+void Waiter::unwait() {
+  for (int i = 0; i < waiterCount; i++) {
+    if (waiters[i] == this) {
+      waiters[i] = waiters[--waiterCount];
+      break;
+    }
+  }
+  waiting = false;
+}
+
+void Waiter::wait(std::coroutine_handle<> awaiting) {
+  if (waiterCount >= waiterCapacity) {
+    // Shouldn't happen, but dropping one would leave its coroutine stuck forever
+    Waiter** grown = new Waiter*[waiterCapacity * 2];
+    std::copy(waiters, waiters + waiterCount, grown);
+    if (waiters != fixedWaiters) delete[] waiters;
+    waiters = grown;
+    waiterCapacity *= 2;
+    printf("More than %i coroutines waiting, made room for %i on the heap\n", waiterCount, waiterCapacity);
+  }
+  handle = awaiting;
+  waiting = true;
+  polled = tickCount;  // First check is next tick, like pid_wait()
+  waiters[waiterCount++] = this;
+}
+
+Waiter::~Waiter() {
+  // A task dropped by whenAny() is destroyed while it's still waiting
+  if (waiting) unwait();
+}
+
+void tick() {
+  tickCount++;
+  while (true) {
+    Waiter* next = nullptr;
+
+    // whenAll() / whenAny() first, so the tasks a whenAny() drops never run again
+    for (int i = 0; i < waiterCount && !next; i++) {
+      if (waiters[i]->combinator() && waiters[i]->ready()) next = waiters[i];
+    }
+
+    // Everything else is checked once per tick, motions count their exit timers in ready()
+    for (int i = 0; i < waiterCount && !next; i++) {
+      Waiter* waiter = waiters[i];
+      if (waiter->combinator() || waiter->polled == tickCount) continue;
+      waiter->polled = tickCount;
+      if (waiter->ready()) next = waiter;
+    }
+
+    if (!next) return;
+    next->unwait();
+    next->handle.resume();
+  }
+}
+
+void run(Task task) {
+  // The auton task gets killed at the end of the period without unwinding, so
+  // anything a killed run left behind is garbage now
+  if (running) {
+    smallFrames.reset(task.address());
+    mediumFrames.reset(task.address());
+    largeFrames.reset(task.address());
+    waiterCount = 0;
+  }
+  running = true;
+
+  task.start();
+  std::uint32_t next_wake = pros::millis();
+  while (!task.done()) {
+    pros::Task::delay_until(&next_wake, ez::util::DELAY_TIME);
+    tick();
+  }
+  running = false;
+}
+
+bool Motion::await_ready() {
+  switch (type) {
+    case DRIVE:
+      driveSet(target * okapi::inch, speed);
+      break;
+    case TURN:
+      turnSet(target * okapi::degree, speed);
+      break;
+    case TURN_RELATIVE:
+      turnRelativeSet(target * okapi::degree, speed);
+      break;
+    case SWING:
+      swingSet(side, target * okapi::degree, speed, opposite_speed);
+      break;
+    case PROFILE:
+      profileDriveSet(profile, backwards);
+      break;
+    case PATH:
+      odomPathSet(*path, speed, backwards);
+      break;
+  }
+  id = motionId();
+  motion_wait.reset();
+  return false;
+}
+
+bool Motion::ready() {
+  // Another motion took over the chassis
+  if (motionId() != id) {
+    exit = ez::RUNNING;
+    return true;
+  }
+  exit = motion_wait.iterate();
+  if (exit == ez::RUNNING) return false;
+  autonTimerMotionEnd(exit, motion_wait.settle_time_get());
+  return true;
+}
+
+}  // namespace co
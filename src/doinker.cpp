@@ -2,9 +2,21 @@
 
 bool out = false;
 
-void doinkerControl(){
-    if(master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_RIGHT)){
-        out = !out;
-    }
+void doinkerToggle(){
+    out = !out;
+    autonTimerEvent(out ? "doinker out" : "doinker in");
     doinker.set_value(out);
-}
\ No newline at end of file
+}
+
+void doinkerSet(bool value){
+    autonTimerEvent(value ? "doinker out" : "doinker in");
+    out = value;
+    doinker.set_value(out);
+}
+
+InputReader doinkerInput;
+
+bool doinkerPressed(){
+    doinkerInput.update();
+    return doinkerInput.pressed(pros::E_CONTROLLER_DIGITAL_RIGHT);
+}
@@ -0,0 +1,52 @@
+#include "executor.hpp"
+
+Executor executor;
+
+void Executor::add(std::string name, std::function<void()> callback, int period, int priority, int modes) {
+  jobs.push_back(std::unique_ptr<Job>(new Job{name, callback, nullptr, period, priority, modes, LoopTimer(name, period), &profilerGet(name)}));
+}
+
+void Executor::add_on_change(std::string name, std::function<bool()> trigger, std::function<void()> callback, int priority, int modes) {
+  jobs.push_back(std::unique_ptr<Job>(new Job{name, callback, trigger, ez::util::DELAY_TIME, priority, modes, LoopTimer(name, ez::util::DELAY_TIME), &profilerGet(name)}));
+}
+
+void Executor::start() {
+  for (auto& job : jobs) {
+    if (job->started) continue;
+    job->started = true;
+    Job* ptr = job.get();
+    pros::Task([this, ptr]() { job_task(ptr); }, job->priority, TASK_STACK_DEPTH_DEFAULT, job->name.c_str());
+  }
+}
+
+void Executor::job_task(Job* job) {
+  job->timer.reset();
+  while (true) {
+    if (mode & job->modes) {
+      if (!job->trigger || job->trigger()) {
+#if PROFILER_ENABLED
+        ScopedTimer timer(*job->histogram);
+#endif
+        job->callback();
+      }
+    }
+    job->timer.wait();
+  }
+}
+
+void Executor::mode_set(e_run_mode input) { mode = input; }
+
+e_run_mode Executor::mode_get() { return (e_run_mode)mode.load(); }
+
+LoopTimer* Executor::timer_get(std::string name) {
+  for (auto& job : jobs) {
+    if (job->name == name) return &job->timer;
+  }
+  return nullptr;
+}
+
+void Executor::stats_print() {
+  for (auto& job : jobs) {
+    job->timer.stats_print();
+  }
+}
@@ -0,0 +1,105 @@
+#include "input.hpp"
+
+#include "EZ-Template/util.hpp"
+#include "pros/rtos.hpp"
+#include "recorder.hpp"
+
+pros::Mutex inputMutex;
+InputSnapshot inputShared;
+std::function<bool(InputSnapshot&)> inputSource;
+
+std::uint16_t inputButtonBit(pros::controller_digital_e_t button) {
+  return 1 << (button - pros::E_CONTROLLER_DIGITAL_L1);
+}
+
+void inputSourceSet(std::function<bool(InputSnapshot&)> source) {
+  inputMutex.take();
+  inputSource = source;
+  inputMutex.give();
+}
+
+bool inputSourceActive() {
+  inputMutex.take();
+  bool active = (bool)inputSource;
+  inputMutex.give();
+  return active;
+}
+
+// Snapshot from the source, an all zero snapshot once it runs out
+bool inputFromSource(InputSnapshot& snapshot) {
+  inputMutex.take();
+  bool from_source = (bool)inputSource;
+  if (from_source && !inputSource(snapshot)) {
+    inputSource = nullptr;
+    snapshot = InputSnapshot();
+  }
+  inputMutex.give();
+  return from_source;
+}
+
+void inputUpdate() {
+  InputSnapshot snapshot;
+  if (inputFromSource(snapshot)) {
+    snapshot.time = pros::millis();
+    inputMutex.take();
+    inputShared = snapshot;
+    inputMutex.give();
+    return;
+  }
+
+  snapshot.time = pros::millis();
+  for (int button = pros::E_CONTROLLER_DIGITAL_L1; button <= pros::E_CONTROLLER_DIGITAL_A; button++) {
+    if (master.get_digital((pros::controller_digital_e_t)button))
+      snapshot.held |= inputButtonBit((pros::controller_digital_e_t)button);
+  }
+  for (int axis = pros::E_CONTROLLER_ANALOG_LEFT_X; axis <= pros::E_CONTROLLER_ANALOG_RIGHT_Y; axis++) {
+    snapshot.analog[axis] = master.get_analog((pros::controller_analog_e_t)axis);
+  }
+
+  inputMutex.take();
+  inputShared = snapshot;
+  inputMutex.give();
+
+  recorderCapture(snapshot);
+}
+
+InputSnapshot inputLatest() {
+  inputMutex.take();
+  InputSnapshot snapshot = inputShared;
+  inputMutex.give();
+  return snapshot;
+}
+
+bool inputChordHeld() {
+  return inputLatest().held & inputButtonBit(INPUT_CHORD);
+}
+
+InputReader::InputReader(input_chords chords) : chords(chords) {}
+
+void InputReader::update() {
+  last_held = current.held;
+  current = inputLatest();
+  if (chords == CHORDS_SEEN) return;
+
+  if (current.held & inputButtonBit(INPUT_CHORD)) chord_held |= current.held;
+  chord_held &= current.held;
+  current.held &= ~chord_held;
+}
+
+bool InputReader::held(pros::controller_digital_e_t button) {
+  return current.held & inputButtonBit(button);
+}
+
+bool InputReader::pressed(pros::controller_digital_e_t button) {
+  return (current.held & ~last_held) & inputButtonBit(button);
+}
+
+bool InputReader::released(pros::controller_digital_e_t button) {
+  return (~current.held & last_held) & inputButtonBit(button);
+}
+
+int InputReader::analog(pros::controller_analog_e_t axis) {
+  return current.analog[axis];
+}
+
+InputSnapshot InputReader::snapshot() { return current; }
@@ -5,40 +5,83 @@
 #include "pros/rtos.hpp"
 #include "subsystems.hpp"
 
+// small reverse to unjam the ring
+Macro intakeReverse({
+    {[](){ intake.move(-40); }, 50},
+    {[](){ intake.move(0); }, 0},
+});
+
+// pulses the intake 7 times then backs the ring off
+Macro intakePulse({
+    {[](){ intake.move(127); }, 65}, {[](){ intake.move(0); }, 10},
+    {[](){ intake.move(127); }, 65}, {[](){ intake.move(0); }, 10},
+    {[](){ intake.move(127); }, 65}, {[](){ intake.move(0); }, 10},
+    {[](){ intake.move(127); }, 65}, {[](){ intake.move(0); }, 10},
+    {[](){ intake.move(127); }, 65}, {[](){ intake.move(0); }, 10},
+    {[](){ intake.move(127); }, 65}, {[](){ intake.move(0); }, 10},
+    {[](){ intake.move(127); }, 65}, {[](){ intake.move(0); }, 10},
+    {[](){ intake.move(-40); }, 50},
+    {[](){ intake.move(0); }, 0},
+});
+
+InputReader intakeInput;
+
 void intakeControl(){
-    if (master.get_digital(DIGITAL_R1)){
-        intake.move(127);
-    } else if (master.get_digital(pros::E_CONTROLLER_DIGITAL_R2)) {
-        intake.move(-127);
-    } else {
-        intake.move(0);
+    int now = pros::millis();
+    intakeInput.update();
+
+    if(intakeInput.pressed(pros::E_CONTROLLER_DIGITAL_LEFT)){
+        liftScoreIntakeRelease();
+        intakePulse.cancel();
+        intakeReverse.start(now);
     }
 
-    if(master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_LEFT)){
-        intake.move(-40);
-        pros::delay(50);
-        intake.move(0);
+    if(intakeInput.pressed(pros::E_CONTROLLER_DIGITAL_A)){
+        liftScoreIntakeRelease();
+        intakeReverse.cancel();
+        intakePulse.start(now);
     }
 
-    if(master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A)){
-        for (int i = 0; i < 7; i++) {
-            intake.move(127);
-            pros::delay(65);
-            intake.move(0);
-            pros::delay(10);
-        }
+    // pressing R1 or R2 takes the intake back from a macro or the lift score
+    if (intakeInput.pressed(DIGITAL_R1) || intakeInput.pressed(pros::E_CONTROLLER_DIGITAL_R2)) {
+        liftScoreIntakeRelease();
+        intakeReverse.cancel();
+        intakePulse.cancel();
+    }
 
-        intake.move(-40);
-        pros::delay(50);
+    intakeReverse.iterate(now);
+    intakePulse.iterate(now);
+
+    // a macro or the lift score is driving the intake this cycle
+    if (!intakeReverse.is_done() || !intakePulse.is_done() || liftScoreUsingIntake()) {
+        return;
+    }
+
+    if (intakeInput.held(DIGITAL_R1)){
+        intake.move(127);
+    } else if (intakeInput.held(pros::E_CONTROLLER_DIGITAL_R2)) {
+        intake.move(-127);
+    } else {
         intake.move(0);
     }
-    
+}
+
+// stops the intake and whatever macro is running it
+void intakeStop(){
+    liftScoreIntakeRelease();
+    intakeReverse.cancel();
+    intakePulse.cancel();
+    intake.move(0);
 }
 
 void intakeOn(){
+    autonTimerEvent("intakeOn");
+    liftScoreIntakeRelease();
     intake.move(127);
 }
 
 void intakeOff(){
+    autonTimerEvent("intakeOff");
+    liftScoreIntakeRelease();
     intake.move(0);
 }
@@ -0,0 +1,102 @@
+#include "main.h"
+
+// joystick has to move past this to count as an input
+const int LATENCY_STICK_THRESHOLD = 15;
+// drive motors have to go faster than this (rpm) to count as moving
+const int LATENCY_VELOCITY_THRESHOLD = 5;
+// robot has to sit still this long before the next sample
+const int LATENCY_REST_TIME = 250;
+// give up on a sample after this long
+const int LATENCY_TIMEOUT = 500;
+
+enum latency_state { LATENCY_REST = 0,
+                     LATENCY_ARMED = 1,
+                     LATENCY_MEASURING = 2 };
+
+bool latencyOn = false;
+latency_state latencyState = LATENCY_REST;
+int latencyRestStart = 0;
+int latencyInputTime = 0;
+int latencyCommandTime = 0;
+InputReader latencyInput;
+
+Histogram& latencyCommand = profilerGet("latency cmd", 1000);
+Histogram& latencyMotor = profilerGet("latency motor", 1000);
+
+// fastest any drive motor is spinning
+double latencyVelocity(){
+    double fastest = 0;
+    for (auto motor : chassis.left_motors) fastest = std::max(fastest, std::abs(motor.get_actual_velocity()));
+    for (auto motor : chassis.right_motors) fastest = std::max(fastest, std::abs(motor.get_actual_velocity()));
+    return fastest;
+}
+
+void latencyIterate(){
+    if (!latencyOn) return;
+
+    latencyInput.update();
+    InputSnapshot input = latencyInput.snapshot();
+    int now = pros::millis();
+    bool stick_moved = std::abs(input.analog[ANALOG_LEFT_Y]) > LATENCY_STICK_THRESHOLD || std::abs(input.analog[ANALOG_RIGHT_X]) > LATENCY_STICK_THRESHOLD;
+    bool drive_moving = latencyVelocity() > LATENCY_VELOCITY_THRESHOLD;
+
+    switch (latencyState) {
+        // wait for sticks to be released and the robot to stop
+        case LATENCY_REST:
+            if (stick_moved || drive_moving) {
+                latencyRestStart = now;
+            } else if (now - latencyRestStart > LATENCY_REST_TIME) {
+                latencyState = LATENCY_ARMED;
+            }
+            break;
+
+        // wait for the stick to move, time from when the brain saw it
+        case LATENCY_ARMED:
+            if (stick_moved) {
+                latencyInputTime = input.time;
+                latencyCommandTime = 0;
+                latencyState = LATENCY_MEASURING;
+            }
+            break;
+
+        case LATENCY_MEASURING: {
+            std::vector<int> command = chassis.drive_get();
+            if (latencyCommandTime == 0 && (command[0] != 0 || command[1] != 0)) {
+                latencyCommandTime = now;
+                latencyCommand.record((now - latencyInputTime) * 1000);
+            }
+            if (drive_moving) {
+                latencyMotor.record((now - latencyInputTime) * 1000);
+                latencyRestStart = now;
+                latencyState = LATENCY_REST;
+            } else if (now - latencyInputTime > LATENCY_TIMEOUT) {
+                latencyRestStart = now;
+                latencyState = LATENCY_REST;
+            }
+            break;
+        }
+    }
+}
+
+void latencyPrint(Histogram& histogram){
+    printf("%s: %i samples, p50 %ims, p99 %ims, max %ims\n", histogram.name_get().c_str(), histogram.count_get(),
+           histogram.percentile(0.5) / 1000, histogram.percentile(0.99) / 1000, histogram.max_get() / 1000);
+}
+
+void latencyToggle(){
+    latencyOn = !latencyOn;
+    latencyState = LATENCY_REST;
+    latencyRestStart = pros::millis();
+    if (latencyOn) {
+        latencyCommand.reset();
+        latencyMotor.reset();
+        printf("Latency measuring on, push a stick from rest a bunch of times\n");
+    } else {
+        latencyPrint(latencyCommand);
+        latencyPrint(latencyMotor);
+    }
+}
+
+bool latencyEnabled(){
+    return latencyOn;
+}
@@ -1,46 +1,112 @@
 #include "EZ-Template/util.hpp"
 #include "main.h"
 #include "pros/misc.h"
+#include "pros/rtos.hpp"
 #include "subsystems.hpp"
 
+const int LIFT_DOWN = 0;
+const int LIFT_LOAD = 475;
+const int LIFT_SCORE = 1875;
+
+// how close the lift has to be to call the score finished
+const int LIFT_SCORE_TOLERANCE = 30;
+
+// true until something else takes the intake, so the score doesn't stop it out from under them
+bool liftScoreOwnsIntake = false;
+
+// backs the ring off with the intake, then raises the arm
+Macro liftScoreMacro({
+    {[](){ intake.move(-20); }, 200},
+    {[](){ if (liftScoreOwnsIntake) intake.move(0); liftScoreOwnsIntake = false; lift.move_absolute(LIFT_SCORE, 127); }, 0},
+});
+pros::Mutex liftScoreMutex;
+bool liftScoreActive = false;
+
+
+InputReader liftInput;
+
 void liftControl(){
+    liftInput.update();
+
     // original get ring position
-    if(master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_B)){
-        lift.move_absolute(475, 127);
+    if(liftInput.pressed(pros::E_CONTROLLER_DIGITAL_B)){
+        liftLoad();
     }
     // scoring position
-    if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1)) {
-        intake.move(-20);
-        pros::delay(200);
-        intake.move(0);
-        lift.move_absolute(1875, 127);
+    if (liftInput.pressed(pros::E_CONTROLLER_DIGITAL_L1)) {
+        liftScore();
     }
     // back to default
-    if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_DOWN)) {
-        lift.move_absolute(0, 127);
+    if (liftInput.pressed(pros::E_CONTROLLER_DIGITAL_DOWN)) {
+        liftDown();
     }
    
 }
 
 void liftLoad(){
-    lift.move_absolute(475, 127);
+    autonTimerEvent("liftLoad");
+    liftScoreCancel();
+    lift.move_absolute(LIFT_LOAD, 127);
 }
 
-void lfitDown(){
-    lift.move_absolute(0, 127);
+void liftDown(){
+    autonTimerEvent("liftDown");
+    liftScoreCancel();
+    lift.move_absolute(LIFT_DOWN, 127);
 }
 
 void liftScore(){
-    intake.move(-20);
-    pros::delay(200);
-    intake.move(0);
-    lift.move_absolute(1875, 127);
+    autonTimerEvent("liftScore");
+    liftScoreMutex.take();
+    liftScoreOwnsIntake = true;
+    liftScoreMacro.start(pros::millis());
+    liftScoreActive = true;
+    liftScoreMutex.give();
+}
+
+// runs from the executor in both driver and auton so nothing has to wait on the score
+void liftScoreIterate(){
+    liftScoreMutex.take();
+    liftScoreMacro.iterate(pros::millis());
+    liftScoreMutex.give();
+}
+
+bool liftScoreDone(){
+    liftScoreMutex.take();
+    bool done = !liftScoreActive || (liftScoreMacro.is_done() && std::abs(lift.get_position() - LIFT_SCORE) < LIFT_SCORE_TOLERANCE);
+    liftScoreMutex.give();
+    return done;
+}
+
+bool liftScoreUsingIntake(){
+    liftScoreMutex.take();
+    bool using_intake = !liftScoreMacro.is_done() && liftScoreOwnsIntake;
+    liftScoreMutex.give();
+    return using_intake;
+}
+
+void liftScoreCancel(){
+    liftScoreMutex.take();
+    // don't leave the intake backing out if we stop halfway
+    if (!liftScoreMacro.is_done() && liftScoreOwnsIntake) intake.move(0);
+    liftScoreOwnsIntake = false;
+    liftScoreMacro.cancel();
+    liftScoreActive = false;
+    liftScoreMutex.give();
+}
+
+void liftScoreIntakeRelease(){
+    liftScoreMutex.take();
+    liftScoreOwnsIntake = false;
+    liftScoreMutex.give();
 }
 
 void intakeUp(){
+    autonTimerEvent("intakeUp");
     intakePiston.set_value(0);
 }
 
 void intakeDown(){
+    autonTimerEvent("intakeDown");
     intakePiston.set_value(1);
-}
\ No newline at end of file
+}
@@ -0,0 +1,64 @@
+#include "loop_timer.hpp"
+
+#include "pros/rtos.hpp"
+
+LoopTimer::LoopTimer(std::string name, int period) : name(name), period(period) {}
+
+void LoopTimer::reset() {
+  next_wake = pros::millis();
+  cycle_start = pros::micros();
+  last_wake = cycle_start;
+}
+
+void LoopTimer::period_set(int input) { period = input; }
+
+int LoopTimer::period_get() { return period; }
+
+void LoopTimer::wait() {
+  if (cycle_start == 0) reset();
+
+  // Time the loop body took this cycle
+  int latency = pros::micros() - cycle_start;
+  stats.latency_max = std::max(stats.latency_max, latency);
+  latency_total += latency;
+  if (latency > period * 1000) stats.overruns++;
+
+  // If we're more than a whole period past the next wake, start fresh
+  // instead of running a burst of back to back loops to catch up
+  std::uint32_t due = next_wake + period;  // delay_until() wakes here
+  if ((std::int32_t)(pros::millis() - due) > period)
+    next_wake = pros::millis() - period;
+  pros::Task::delay_until(&next_wake, period);
+
+  std::uint64_t now = pros::micros();
+  int jitter = std::abs((int)(now - last_wake) - period * 1000);
+  last_wake = now;
+  cycle_start = now;
+
+  stats.cycles++;
+  stats.jitter_max = std::max(stats.jitter_max, jitter);
+  jitter_total += jitter;
+  stats.latency_avg = latency_total / stats.cycles;
+  stats.jitter_avg = jitter_total / stats.cycles;
+}
+
+LoopTimer::Stats LoopTimer::stats_get() { return stats; }
+
+void LoopTimer::stats_reset() {
+  stats = Stats();
+  latency_total = 0.0;
+  jitter_total = 0.0;
+}
+
+std::string LoopTimer::stats_string() {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%ims max%.2f jit%.2f ovr%i", period, stats.latency_max / 1000.0, stats.jitter_max / 1000.0, stats.overruns);
+  return buffer;
+}
+
+void LoopTimer::stats_print() {
+  printf("%s loop (%ims): %i cycles, %i overruns, body avg %.2fms max %.2fms, jitter avg %.2fms max %.2fms\n",
+         name.c_str(), period, stats.cycles, stats.overruns,
+         stats.latency_avg / 1000.0, stats.latency_max / 1000.0,
+         stats.jitter_avg / 1000.0, stats.jitter_max / 1000.0);
+}
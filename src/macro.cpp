@@ -0,0 +1,36 @@
+#include "macro.hpp"
+
+Macro::Macro(std::vector<Step> steps) : steps(steps) {}
+
+void Macro::start(int now) {
+  current = 0;
+  running = !steps.empty();
+  if (running) step_enter(now);
+}
+
+void Macro::cancel() {
+  running = false;
+}
+
+bool Macro::is_done() {
+  return !running;
+}
+
+void Macro::step_enter(int now) {
+  step_start = now;
+  if (steps[current].action) steps[current].action();
+}
+
+void Macro::iterate(int now) {
+  // Move through every step whose time is up, so a late cycle or a 0ms step
+  // never leaves the motor on an old command for an extra loop
+  while (running && now - step_start >= steps[current].time) {
+    int next_start = step_start + steps[current].time;
+    current++;
+    if (current >= (int)steps.size()) {
+      running = false;
+      return;
+    }
+    step_enter(next_start);
+  }
+}
@@ -15,8 +15,28 @@ ez::Drive chassis(
     {18, 19, -20},  // Right Chassis Ports (negative port will reverse it!)
 
     5,      // IMU Port
-    3.25,  // Wheel Diameter (Remember, 4" wheels without screw holes are actually 4.125!)
-    480);   // Wheel RPM
+    DRIVE_WHEEL_DIAMETER,  // Wheel Diameter, see subsystems.hpp
+    DRIVE_WHEEL_RPM);      // Wheel RPM
+
+InputReader driveInput;
+
+/**
+ * Driver control for the chassis, runs from the executor.
+ * This is chassis.opcontrol_arcade_standard(ez::SPLIT) reading the input snapshot instead of the controller.
+ */
+void driveControl() {
+  driveInput.update();
+
+  // The curve buttons still read the controller themselves, they're only used for tuning the curve.
+  // Y and A are also chord buttons, so they're left alone while UP is held
+  if (chassis.opcontrol_curve_buttons_toggle_get() && !inputChordHeld())
+    chassis.opcontrol_curve_buttons_iterate();
+
+  // Standard split arcade, left stick forward and right stick turn
+  int fwd_stick = chassis.opcontrol_curve_left(driveInput.analog(ANALOG_LEFT_Y));
+  int turn_stick = chassis.opcontrol_curve_right(driveInput.analog(ANALOG_RIGHT_X));
+  chassis.opcontrol_joystick_threshold_iterate(fwd_stick + turn_stick, fwd_stick - turn_stick);  // Applies the joystick threshold and active brake
+}
 
 /**
  * Runs initialization code. This occurs as soon as the program is started.
@@ -37,6 +57,7 @@ void initialize() {
 
   // Set the drive to your own constants from autons.cpp!
   default_constants();
+  autotuneLoad();  // Turn and swing constants from the last autotune on the SD card, see autotune.hpp
 
   // These are already defaulted to these buttons, but you can change the left/right curve buttons here!
   // chassis.opcontrol_curve_buttons_left_set(pros::E_CONTROLLER_DIGITAL_LEFT, pros::E_CONTROLLER_DIGITAL_RIGHT);  // If using tank, only the left side is used.
@@ -53,13 +74,43 @@ void initialize() {
       Auton("RED ELims NEGATIVE", redElimNegative),
       Auton("BLUE Elims POSITIVE", blueElimPositive),
       Auton("BLUE Elims Negative", blueElimNegative),
+      Auton("SKILLS", skills),
   });
 
+  // Skills can be started from any checkpoint, put the robot at the pose printed in the terminal
+  ez::as::auton_selector.autons_add(skillsCheckpoints());
+
+  // Spline paths come off the SD card now so autons never wait on making one
+  autonSplines();
+  splinesLoad();
+
+  // Driver recordings on the SD card play back as autons, see recorder.hpp
+  for (int slot = 0; slot < RECORDER_SLOTS; slot++) {
+    if (recorderExists(slot))
+      ez::as::auton_selector.autons_add({Auton("REPLAY rec" + std::to_string(slot), [slot]() { recorderReplay(slot); })});
+  }
+
   // Initialize chassis and auton selector
   chassis.initialize();
   ez::as::initialize();
   master.rumble(".");
   lift.tare_position();
+
+  // Every subsystem runs in its own task at its own rate, so a slow one can't hold up the drive
+  executor.add("input", inputUpdate, 10, TASK_PRIORITY_DEFAULT + 3, RUN_ALWAYS);  // Samples the controller once per cycle for everything else
+  executor.add("odom", odomIterate, 10, TASK_PRIORITY_DEFAULT + 4, RUN_ALWAYS);  // Above every reader so odomGet() never waits on it
+  executor.add("drive", driveControl, 10, TASK_PRIORITY_DEFAULT + 2);
+  executor.add("intake", intakeControl, 10, TASK_PRIORITY_DEFAULT + 1);
+  executor.add("lift", liftControl, 20, TASK_PRIORITY_DEFAULT);
+  executor.add("lift score", liftScoreIterate, 10, TASK_PRIORITY_DEFAULT + 1, RUN_ALWAYS);
+  executor.add("latency", latencyIterate, 5, TASK_PRIORITY_DEFAULT + 1);  // Only does anything while latencyToggle() is on
+  executor.add("odom motion", odomMotionIterate, 10, TASK_PRIORITY_DEFAULT + 2, RUN_AUTONOMOUS);  // Drives pose and point motions, see odom_motion.hpp
+  executor.add("markers", markersIterate, 10, TASK_PRIORITY_DEFAULT + 2, RUN_AUTONOMOUS);  // Fires callbacks partway through chassis motions
+  executor.add("recorder", recorderFlush, 50, TASK_PRIORITY_DEFAULT - 2, RUN_ALWAYS);  // Writes driver recordings to the SD card away from the control loops
+  executor.add("pistons", CachedDigitalOut::flush_all, 10, TASK_PRIORITY_DEFAULT + 1, RUN_ALWAYS);  // One ADI write per piston per cycle, only on changes
+  executor.add_on_change("clamp", clampPressed, clampToggle, TASK_PRIORITY_DEFAULT - 1);
+  executor.add_on_change("doinker", doinkerPressed, doinkerToggle, TASK_PRIORITY_DEFAULT - 1);
+  executor.start();
 }
 
 
@@ -69,7 +120,10 @@ void initialize() {
  * the robot is enabled, this task will exit.
  */
 void disabled() {
-  // . . .
+  executor.mode_set(RUN_DISABLED);
+  inputSourceSet(nullptr);  // A replay cut off by the end of the period stops here
+  mirrorSet(false);         // So does a red auton, which never got to turn mirroring off
+  autonTimerReport();  // The auton task is killed at the end of the period, so report from here if it didn't finish
 }
 
 /**
@@ -97,12 +151,17 @@ void competition_initialize() {
  * from where it left off.
  */
 void autonomous() {
+  mirrorSet(false);                           // Red autons turn it on themselves, a killed one can't turn it off
   chassis.pid_targets_reset();                // Resets PID targets to 0
-  chassis.drive_imu_reset();                  // Reset gyro position to 0
-  chassis.drive_sensor_reset();               // Reset drive sensors to 0
+  odomImuReset();                             // Reset gyro position to 0
+  odomSensorsReset();                         // Reset drive sensors to 0
   chassis.drive_brake_set(MOTOR_BRAKE_HOLD);  // Set motors to hold.  This helps autonomous consistency
+  odomSet(Pose());                            // Autons start at the origin
+  executor.mode_set(RUN_AUTONOMOUS);          // Stop driver control jobs from fighting the auton
 
+  autonTimerStart(15000);                        // Times every step, skills bumps this to 60s
   ez::as::auton_selector.selected_auton_call();  // Calls selected auton from autonomous selector
+  autonTimerReport();
 }
 
 
@@ -123,15 +182,25 @@ void autonomous() {
 void opcontrol() {
   // This is preference to what you like to drive on
   pros::motor_brake_mode_e_t driver_preference_brake = MOTOR_BRAKE_COAST;
+  inputSourceSet(nullptr);  // The driver gets the controller back from a replay that was still going
+  // Resets drive sensors once after an auton, chassis.opcontrol_drive_sensors_reset() through odometry
+  if (ez::util::AUTON_RAN) {
+    odomSensorsReset();
+    ez::util::AUTON_RAN = false;
+  }
   intakePiston.set_value(1);
-  doinker.set_value(0);
+  doinkerSet(false);
   chassis.drive_brake_set(driver_preference_brake);
   lift.move_absolute(0, 127);
-  
+  executor.mode_set(RUN_OPCONTROL);
 
+  InputReader opcontrol_input(CHORDS_SEEN);
+  LoopTimer opcontrol_timer("opcontrol", ez::util::DELAY_TIME);  // This is used for timer calculations!  Keep this ez::util::DELAY_TIME
+  opcontrol_timer.reset();
 
-  
   while (true) {
+    opcontrol_input.update();
+
     // PID Tuner
     // After you find values that you're happy with, you'll have to set them in auton.cpp
     if (!pros::competition::is_connected()) {
@@ -139,36 +208,58 @@ void opcontrol() {
       //  When enabled:
       //  * use A and Y to increment / decrement the constants
       //  * use the arrow keys to navigate the constants
-      if (master.get_digital_new_press(DIGITAL_X))
+      if (opcontrol_input.pressed(DIGITAL_X) && !opcontrol_input.held(DIGITAL_UP))
         chassis.pid_tuner_toggle();
 
       // Trigger the selected autonomous routine
-      if (master.get_digital(DIGITAL_B) && master.get_digital(DIGITAL_DOWN)) {
+      if (opcontrol_input.held(DIGITAL_B) && opcontrol_input.held(DIGITAL_DOWN)) {
         autonomous();
         chassis.drive_brake_set(driver_preference_brake);
+        executor.mode_set(RUN_OPCONTROL);
       }
 
       chassis.pid_tuner_iterate();  // Allow PID Tuner to iterate
-    }
 
-    // chassis.opcontrol_tank();  // Tank control
-     chassis.opcontrol_arcade_standard(ez::SPLIT);   // Standard split arcade
-    // chassis.opcontrol_arcade_standard(ez::SINGLE);  // Standard single arcade
-    // chassis.opcontrol_arcade_flipped(ez::SPLIT);    // Flipped split arcade
-    // chassis.opcontrol_arcade_flipped(ez::SINGLE);   // Flipped single arcade
+      // Hold UP and press X to print how long each subsystem takes to the terminal and save it to the SD card
+      if (opcontrol_input.held(DIGITAL_UP) && opcontrol_input.pressed(DIGITAL_X)) {
+        profilerPrint();
+        profilerSave();
+      }
+
+      // Chords hold UP, the subsystems don't see the buttons pressed with it
+      // Hold UP and press DOWN to start / stop measuring joystick to drive latency
+      if (opcontrol_input.held(DIGITAL_UP) && opcontrol_input.pressed(DIGITAL_DOWN))
+        latencyToggle();
+
+      // Hold UP and press Y to start / stop recording driver control to the SD card
+      if (opcontrol_input.held(DIGITAL_UP) && opcontrol_input.pressed(DIGITAL_Y))
+        recorderToggle();
+
+      // Hold UP and press A to autotune turns, or B to autotune swings.  The robot spins in place for a while
+      if (opcontrol_input.held(DIGITAL_UP) && (opcontrol_input.pressed(DIGITAL_A) || opcontrol_input.pressed(DIGITAL_B))) {
+        autotuneRun(opcontrol_input.pressed(DIGITAL_A) ? AUTOTUNE_TURN : AUTOTUNE_SWING);
+        chassis.drive_brake_set(driver_preference_brake);
+        executor.mode_set(RUN_OPCONTROL);
+      }
+    }
 
     // . . .
     // Put more user control code here!
+    // Subsystems run from the executor, add them in initialize()
     // . . .
 
-    clampControl();
-    intakeControl();
-    liftControl();
-    doinkerControl();
-    // autonTestor();
+    // autonTestor(opcontrol_input);
 
-    
+    // Drive loop timing on the brain every second and every loop in the terminal every 5 seconds
+    int cycles = opcontrol_timer.stats_get().cycles;
+    if (cycles % 100 == 0 && !chassis.pid_tuner_enabled())
+      ez::screen_print(executor.timer_get("drive")->stats_string(), 7);
+    if (cycles % 500 == 0) {
+      opcontrol_timer.stats_print();
+      executor.stats_print();
+      CachedDigitalOut::stats_print();
+    }
 
-    pros::delay(ez::util::DELAY_TIME);  // This is used for timer calculations!  Keep this ez::util::DELAY_TIME
+    opcontrol_timer.wait();  // Holds the loop at a fixed ez::util::DELAY_TIME period
   }
 }
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "motion.hpp"
+
+#include "auton_timer.hpp"
+#include "odom_motion.hpp"
+#include "pros/rtos.hpp"
+
+extern ez::Drive chassis;
+
+static bool mirrored = false;
+static unsigned motionCount = 0;
+
+void MotionWait::reset() {
+  left_exit = ez::RUNNING;
+  right_exit = ez::RUNNING;
+  exit = ez::RUNNING;
+  settle_start = -1;
+  settle_time = 0;
+}
+
+int MotionWait::settle_time_get() {
+  return settle_time;
+}
+
+// How far the running motion is from its target, and how close counts as settling
+static void motionError(double& error, double& settle_error) {
+  switch (chassis.drive_mode_get()) {
+    // From the sensors, the PID's error is stale until the drive task runs after a new target
+    case ez::DRIVE:
+      error = std::max(std::abs(chassis.leftPID.target_get() - chassis.drive_sensor_left()), std::abs(chassis.rightPID.target_get() - chassis.drive_sensor_right()));
+      settle_error = chassis.leftPID.exit.big_error;
+      break;
+    case ez::SWING:
+      error = std::abs(chassis.swingPID.target_get() - chassis.drive_imu_get());
+      settle_error = chassis.swingPID.exit.big_error;
+      break;
+    case ez::TURN:
+      error = std::abs(chassis.turnPID.target_get() - chassis.drive_imu_get());
+      settle_error = chassis.turnPID.exit.big_error;
+      break;
+    default:
+      // Odom motions drive with EZ disabled
+      error = odomMotionError();
+      settle_error = chassis.leftPID.exit.big_error;
+      break;
+  }
+}
+
+// Same checks as chassis.pid_wait(), one loop at a time
+ez::exit_output MotionWait::iterate() {
+  if (exit != ez::RUNNING) return exit;
+
+  bool print = chassis.pid_print_toggle_get();
+  switch (chassis.drive_mode_get()) {
+    case ez::DRIVE:
+      if (left_exit == ez::RUNNING) left_exit = chassis.leftPID.exit_condition(chassis.left_motors[0], print);
+      if (right_exit == ez::RUNNING) right_exit = chassis.rightPID.exit_condition(chassis.right_motors[0], print);
+      if (left_exit != ez::RUNNING && right_exit != ez::RUNNING)
+        exit = std::max(left_exit, right_exit);
+      break;
+    case ez::TURN:
+      exit = chassis.turnPID.exit_condition({chassis.left_motors[0], chassis.right_motors[0]}, print);
+      break;
+    case ez::SWING:
+      exit = chassis.swingPID.exit_condition(chassis.current_swing == ez::LEFT_SWING ? chassis.left_motors[0] : chassis.right_motors[0], print);
+      break;
+    default:
+      // An odom motion, or nothing is running
+      exit = odomMotionExit(print);
+      break;
+  }
+
+  if (exit == ez::mA_EXIT || exit == ez::VELOCITY_EXIT) chassis.interfered = true;
+
+  int now = pros::millis();
+  double error, settle_error;
+  motionError(error, settle_error);
+  if (settle_start == -1 && error < settle_error) settle_start = now;
+  if (exit != ez::RUNNING) settle_time = settle_start == -1 ? 0 : now - settle_start;
+  return exit;
+}
+
+std::function<bool()> driveErrorBelow(double inches) {
+  return [inches]() {
+    return std::abs(chassis.leftPID.target_get() - chassis.drive_sensor_left()) < inches &&
+           std::abs(chassis.rightPID.target_get() - chassis.drive_sensor_right()) < inches;
+  };
+}
+
+std::function<bool()> turnErrorBelow(double degrees) {
+  return [degrees]() {
+    PID& pid = chassis.drive_mode_get() == ez::SWING ? chassis.swingPID : chassis.turnPID;
+    return std::abs(pid.target_get() - chassis.drive_imu_get()) < degrees;
+  };
+}
+
+std::function<bool()> headingPast(double degrees) {
+  return [degrees]() {
+    PID& pid = chassis.drive_mode_get() == ez::SWING ? chassis.swingPID : chassis.turnPID;
+    // Past it once we're closer to the target than it is
+    return std::abs(pid.target_get() - chassis.drive_imu_get()) <= std::abs(pid.target_get() - mirrorAngle(degrees));
+  };
+}
+
+void mirrorSet(bool mirror) {
+  mirrored = mirror;
+}
+
+bool mirrorGet() {
+  return mirrored;
+}
+
+double mirrorAngle(double degrees) {
+  return mirrored ? -degrees : degrees;
+}
+
+void runMirrored(std::function<void()> auton) {
+  mirrorSet(true);
+  auton();
+  mirrorSet(false);
+}
+
+static ez::e_swing mirrorSwing(ez::e_swing type) {
+  if (!mirrored) return type;
+  return type == ez::LEFT_SWING ? ez::RIGHT_SWING : ez::LEFT_SWING;
+}
+
+// Name of a motion in the auton timing report, ie. "turn -30.0deg"
+static std::string motionName(const char* type, double target, const char* units) {
+  char name[48];
+  snprintf(name, sizeof(name), "%s %.1f%s", type, target, units);
+  return name;
+}
+
+unsigned motionId() {
+  return motionCount;
+}
+
+void driveSet(okapi::QLength target, int speed, bool slew_on, bool toggle_heading) {
+  double inches = target.convert(okapi::inch);
+  motionCount++;
+  autonTimerMotion(motionName("drive", inches, "in"));
+  chassis.pid_drive_set(inches, speed, slew_on, toggle_heading);
+}
+
+void pidWait() {
+  MotionWait wait;
+  std::uint32_t next_wake = pros::millis();
+  ez::exit_output exit;
+  while ((exit = wait.iterate()) == ez::RUNNING) {
+    pros::Task::delay_until(&next_wake, ez::util::DELAY_TIME);
+  }
+  autonTimerMotionEnd(exit, wait.settle_time_get());
+}
+
+void turnSet(okapi::QAngle target, int speed, bool slew_on) {
+  double degrees = mirrorAngle(target.convert(okapi::degree));
+  motionCount++;
+  autonTimerMotion(motionName("turn", degrees, "deg"));
+  chassis.pid_turn_set(degrees, speed, slew_on);
+}
+
+void turnRelativeSet(okapi::QAngle target, int speed, bool slew_on) {
+  double degrees = mirrorAngle(target.convert(okapi::degree));
+  motionCount++;
+  autonTimerMotion(motionName("turn relative", degrees, "deg"));
+  chassis.pid_turn_relative_set(degrees, speed, slew_on);
+}
+
+void swingSet(ez::e_swing type, okapi::QAngle target, int speed, int opposite_speed, bool slew_on) {
+  double degrees = mirrorAngle(target.convert(okapi::degree));
+  motionCount++;
+  autonTimerMotion(motionName(mirrorSwing(type) == ez::LEFT_SWING ? "left swing" : "right swing", degrees, "deg"));
+  chassis.pid_swing_set(mirrorSwing(type), degrees, speed, opposite_speed, slew_on);
+}
+
+void swingRelativeSet(ez::e_swing type, okapi::QAngle target, int speed, int opposite_speed, bool slew_on) {
+  double degrees = mirrorAngle(target.convert(okapi::degree));
+  motionCount++;
+  autonTimerMotion(motionName(mirrorSwing(type) == ez::LEFT_SWING ? "left swing relative" : "right swing relative", degrees, "deg"));
+  chassis.pid_swing_relative_set(mirrorSwing(type), degrees, speed, opposite_speed, slew_on);
+}
+
+void odomPointSet(okapi::QLength x, okapi::QLength y, int speed, bool backwards) {
+  double inches_x = x.convert(okapi::inch) * (mirrored ? -1 : 1);
+  double inches_y = y.convert(okapi::inch);
+  char name[48];
+  snprintf(name, sizeof(name), "point (%.1f, %.1f)", inches_x, inches_y);
+  motionCount++;
+  autonTimerMotion(name);
+  odomMotionStart(inches_x, inches_y, 0, false, speed, backwards);
+}
+
+void odomPoseSet(okapi::QLength x, okapi::QLength y, okapi::QAngle theta, int speed, bool backwards) {
+  double inches_x = x.convert(okapi::inch) * (mirrored ? -1 : 1);
+  double inches_y = y.convert(okapi::inch);
+  double degrees = mirrorAngle(theta.convert(okapi::degree));
+  char name[48];
+  snprintf(name, sizeof(name), "pose (%.1f, %.1f, %.0fdeg)", inches_x, inches_y, degrees);
+  motionCount++;
+  autonTimerMotion(name);
+  odomMotionStart(inches_x, inches_y, degrees, true, speed, backwards);
+}
+
+void odomPathSet(const Path& path, int speed, bool backwards) {
+  char name[48];
+  snprintf(name, sizeof(name), "path (%d points)", path.size());
+  motionCount++;
+  autonTimerMotion(name);
+  odomPathStart(mirrored ? path.mirrored() : path, speed, backwards);
+}
+
+void profileDriveSet(const BakedProfile& profile, bool backwards) {
+  char name[48];
+  snprintf(name, sizeof(name), "profile %s", profile.name);
+  motionCount++;
+  autonTimerMotion(name);
+  odomProfileStart(profile, backwards);
+}
+
+void driveAngleSet(okapi::QAngle angle) {
+  chassis.drive_angle_set(mirrorAngle(angle.convert(okapi::degree)));
+}
+
+// Markers belong to the motion that was running when they were added, found
+// by its mode and target.  Once either changes the motion is over
+struct Marker {
+  ez::e_mode mode;
+  double target;
+  double start;
+  double threshold;
+  std::function<void()> callback;
+};
+
+static std::vector<Marker> markers;
+static pros::Mutex markersMutex;
+
+static double motionTarget(ez::e_mode mode) {
+  switch (mode) {
+    case ez::DRIVE:
+      return chassis.leftPID.target_get();
+    case ez::SWING:
+      return chassis.swingPID.target_get();
+    default:
+      return chassis.turnPID.target_get();
+  }
+}
+
+static double driveTraveled() {
+  return (chassis.drive_sensor_left() + chassis.drive_sensor_right()) / 2.0;
+}
+
+void markerDistance(okapi::QLength distance, std::function<void()> callback) {
+  markersMutex.take();
+  markers.push_back({ez::DRIVE, motionTarget(ez::DRIVE), driveTraveled(), distance.convert(okapi::inch), callback});
+  markersMutex.give();
+}
+
+void markerAngle(okapi::QAngle angle, std::function<void()> callback) {
+  ez::e_mode mode = chassis.drive_mode_get();
+  markersMutex.take();
+  markers.push_back({mode, motionTarget(mode), chassis.drive_imu_get(), mirrorAngle(angle.convert(okapi::degree)), callback});
+  markersMutex.give();
+}
+
+void markersIterate() {
+  std::vector<std::function<void()>> fired;
+
+  markersMutex.take();
+  ez::e_mode mode = chassis.drive_mode_get();
+  for (auto it = markers.begin(); it != markers.end();) {
+    if (it->mode != mode || motionTarget(mode) != it->target) {
+      it = markers.erase(it);
+      continue;
+    }
+
+    bool crossed;
+    if (mode == ez::DRIVE) {
+      // Distance markers count from the start of the motion
+      double traveled = driveTraveled() - it->start;
+      crossed = it->threshold < 0 ? traveled <= it->threshold : traveled >= it->threshold;
+    } else {
+      // Angle markers fire when the heading gets to the other side
+      double heading = chassis.drive_imu_get();
+      crossed = it->start < it->threshold ? heading >= it->threshold : heading <= it->threshold;
+    }
+
+    if (crossed) {
+      fired.push_back(it->callback);
+      it = markers.erase(it);
+    } else {
+      it++;
+    }
+  }
+  markersMutex.give();
+
+  // Callbacks run outside the lock so they can add markers of their own
+  for (auto& callback : fired) callback();
+}
@@ -0,0 +1,179 @@
+#include "main.h"
+
+#include <atomic>
+#include <cmath>
+
+// Anything more than this in one cycle is a sensor being reset behind our back, not the robot moving
+const double ODOM_MAX_DISTANCE = 3.0;  // inches, 300in/s
+const double ODOM_MAX_TURN = 45.0;     // degrees, 4500deg/s
+
+// Published pose.  The sequence number is odd while it's being written
+static std::atomic<unsigned> odomSequence{0};
+static std::atomic<double> odomX{0}, odomY{0}, odomTheta{0};
+
+// Only the odom job touches these
+static Pose odomPose;
+static double odomLeft = 0, odomRight = 0, odomImu = 0;
+static double odomHeadingOffset = 0;  // Added to the IMU to get theta
+static bool odomStarted = false;
+
+// Pose waiting for odomSet() to hand it to the odom job
+static std::atomic<bool> odomSetPending{false};
+static std::atomic<double> odomSetX{0}, odomSetY{0}, odomSetTheta{0};
+
+// Resets waiting for the odom job
+static std::atomic<bool> odomSensorsResetPending{false}, odomImuResetPending{false};
+static std::atomic<double> odomImuResetHeading{0};
+// Resets done while the odom job wasn't running, it carries on from its next read
+static std::atomic<bool> odomSensorsResetDone{false}, odomImuResetDone{false};
+
+static void odomPublish() {
+  unsigned sequence = odomSequence.load(std::memory_order_relaxed);
+  odomSequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  odomX.store(odomPose.x, std::memory_order_relaxed);
+  odomY.store(odomPose.y, std::memory_order_relaxed);
+  odomTheta.store(odomPose.theta, std::memory_order_relaxed);
+  odomSequence.store(sequence + 2, std::memory_order_release);
+}
+
+// The odom job only runs in driver control and auton, there's nothing to wait for while disabled
+static bool odomJobRunning() {
+  return executor.mode_get() != RUN_DISABLED;
+}
+
+static OdomSample odomRead() {
+  OdomSample sample;
+  sample.left = chassis.drive_sensor_left();
+  sample.right = chassis.drive_sensor_right();
+  sample.imu = chassis.drive_imu_get();
+  return sample;
+}
+
+void odomIterate() {
+  OdomSample first = odomRead();
+  first.sensors_reset = odomSensorsResetDone.exchange(false);
+  first.imu_reset = odomImuResetDone.exchange(false);
+  odomUpdate(first);
+
+  // Reset between two reads so nothing the robot drove is lost across it
+  bool expected = true;
+  bool sensors_reset = odomSensorsResetPending.compare_exchange_strong(expected, false);
+  expected = true;
+  bool imu_reset = odomImuResetPending.compare_exchange_strong(expected, false);
+  if (!sensors_reset && !imu_reset) return;
+
+  if (sensors_reset) chassis.drive_sensor_reset();
+  if (imu_reset) chassis.drive_imu_reset(odomImuResetHeading.load());
+  OdomSample sample = odomRead();
+  sample.sensors_reset = sensors_reset;
+  sample.imu_reset = imu_reset;
+  odomUpdate(sample);
+}
+
+void odomUpdate(OdomSample sample) {
+  if (!odomStarted || odomSetPending.load(std::memory_order_acquire)) {
+    if (odomSetPending.load(std::memory_order_acquire)) {
+      odomPose = {odomSetX.load(), odomSetY.load(), odomSetTheta.load()};
+      odomSetPending.store(false, std::memory_order_release);
+    }
+    odomHeadingOffset = odomPose.theta - sample.imu;
+    odomLeft = sample.left;
+    odomRight = sample.right;
+    odomImu = sample.imu;
+    odomStarted = true;
+    odomPublish();
+    return;
+  }
+
+  // Carry on from the new readings, the pose stays where it was
+  if (sample.sensors_reset) {
+    odomLeft = sample.left;
+    odomRight = sample.right;
+  }
+  if (sample.imu_reset) {
+    odomHeadingOffset += odomImu - sample.imu;
+    odomImu = sample.imu;
+  }
+
+  double left_delta = sample.left - odomLeft;
+  double right_delta = sample.right - odomRight;
+  double turn = sample.imu - odomImu;
+  odomLeft = sample.left;
+  odomRight = sample.right;
+  odomImu = sample.imu;
+
+  // Backstop for resets EZ does on its own, which nothing tells us about
+  if (std::abs(turn) > ODOM_MAX_TURN) {
+    odomHeadingOffset -= turn;
+    turn = 0;
+  }
+  if (std::abs(left_delta) > ODOM_MAX_DISTANCE || std::abs(right_delta) > ODOM_MAX_DISTANCE) {
+    left_delta = 0;
+    right_delta = 0;
+  }
+
+  // The robot drove an arc, its chord points halfway between the old and new heading
+  double distance = (left_delta + right_delta) / 2.0;
+  double half_turn = turn * M_PI / 360.0;
+  double chord = std::abs(half_turn) > 1e-6 ? distance * std::sin(half_turn) / half_turn : distance;
+  double heading = (odomPose.theta + turn / 2.0) * M_PI / 180.0;
+  odomPose.x += chord * std::sin(heading);
+  odomPose.y += chord * std::cos(heading);
+  odomPose.theta = sample.imu + odomHeadingOffset;
+
+  odomPublish();
+}
+
+Pose odomGet() {
+  // The odom job runs above every reader, so it's never stuck halfway through
+  // a write while a reader spins here.  A retry only happens when the job
+  // cut in during the copy.
+  while (true) {
+    unsigned sequence = odomSequence.load(std::memory_order_acquire);
+    Pose pose;
+    pose.x = odomX.load(std::memory_order_relaxed);
+    pose.y = odomY.load(std::memory_order_relaxed);
+    pose.theta = odomTheta.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence % 2 == 0 && odomSequence.load(std::memory_order_relaxed) == sequence) return pose;
+  }
+}
+
+void odomSet(Pose pose) {
+  odomSetX.store(pose.x);
+  odomSetY.store(pose.y);
+  odomSetTheta.store(pose.theta);
+  odomSetPending.store(true, std::memory_order_release);
+
+  // A couple of cycles at most, the job picks it up whenever it next runs
+  if (!odomJobRunning()) return;
+  for (int i = 0; i < 3 * ez::util::DELAY_TIME && odomSetPending.load(std::memory_order_acquire); i++) pros::delay(1);
+}
+
+// Waits a couple of cycles for the odom job to do a reset, if it doesn't take
+// it (the executor isn't running yet) takes it back and says so
+static bool odomResetWait(std::atomic<bool>& pending) {
+  if (odomJobRunning()) {
+    for (int i = 0; i < 3 * ez::util::DELAY_TIME && pending.load(); i++) pros::delay(1);
+  }
+  bool expected = true;
+  return pending.compare_exchange_strong(expected, false);
+}
+
+void odomSensorsReset() {
+  odomSensorsResetPending.store(true);
+  if (odomResetWait(odomSensorsResetPending)) {
+    chassis.drive_sensor_reset();
+    odomSensorsResetDone.store(true);
+  }
+}
+
+void odomImuReset(double heading) {
+  odomImuResetHeading.store(heading);
+  odomImuResetPending.store(true);
+  if (odomResetWait(odomImuResetPending)) {
+    chassis.drive_imu_reset(heading);
+    odomImuResetDone.store(true);
+  }
+}
@@ -0,0 +1,314 @@
+#include "main.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+// How far back along the final heading the carrot starts, times the distance left
+const double ODOM_LEAD = 0.5;
+// Inside this many inches the robot stops steering at the point and just settles
+const double ODOM_SETTLE_RADIUS = 6.0;
+// How far ahead on a path the robot steers at
+const double PURSUIT_LOOKAHEAD = 12.0;
+// Power per inch per second, 127 at the drive's free speed
+const double PROFILE_KV = 127.0 / (DRIVE_WHEEL_DIAMETER * M_PI * DRIVE_WHEEL_RPM / 60.0);
+// Power per inch per second squared, pushes the robot's mass through speed changes
+const double PROFILE_KA = 0.2;
+// Power per inch behind or ahead of the profile
+const double PROFILE_KP = 10;
+
+struct OdomTarget {
+  double x = 0;
+  double y = 0;
+  double theta = 0;
+  bool pose = false;
+  int speed = 0;
+  bool backwards = false;
+};
+
+static OdomTarget odomTarget;
+static pros::Mutex odomTargetMutex;
+static std::atomic<bool> odomRunning{false};
+
+// The path being followed, null for point and pose motions.  Guarded by odomTargetMutex
+static std::unique_ptr<Path> odomPath;
+static int odomPathClosest = 0;
+static int odomPathIndex = 0;  // Segment the lookahead point is on
+static double odomPathT = 0;   // How far along it
+
+// The baked profile being driven, no samples for other motions.  Guarded by odomTargetMutex
+static BakedProfile odomProfile = {nullptr, nullptr, 0};
+static Pose odomProfileFrom;
+static std::uint32_t odomProfileTime = 0;
+
+// Distance and heading, with the drive and turn PID's constants and exits
+static ez::PID odomDrivePID;
+static ez::PID odomTurnPID;
+static ez::exit_output odomDriveExit = ez::RUNNING;
+static ez::exit_output odomTurnExit = ez::RUNNING;
+static std::atomic<bool> odomSettling{false};
+
+static double odomWrap(double degrees) {
+  degrees = std::fmod(degrees + 180.0, 360.0);
+  if (degrees < 0) degrees += 360.0;
+  return degrees - 180.0;
+}
+
+static double odomRadians(double degrees) {
+  return degrees * M_PI / 180.0;
+}
+
+static void odomPIDsReset(bool pose) {
+  ez::PID::Constants drive = chassis.forward_drivePID.constants;
+  ez::PID::Constants turn = chassis.turnPID.constants;
+  ez::PID::exit_condition_ drive_exit = chassis.leftPID.exit;
+  ez::PID::exit_condition_ turn_exit = chassis.turnPID.exit;
+  odomDrivePID.constants_set(drive.kp, drive.ki, drive.kd, drive.start_i);
+  odomTurnPID.constants_set(turn.kp, turn.ki, turn.kd, turn.start_i);
+  odomDrivePID.exit_condition_set(drive_exit.small_exit_time, drive_exit.small_error, drive_exit.big_exit_time, drive_exit.big_error, drive_exit.velocity_exit_time, drive_exit.mA_timeout);
+  odomTurnPID.exit_condition_set(turn_exit.small_exit_time, turn_exit.small_error, turn_exit.big_exit_time, turn_exit.big_error, turn_exit.velocity_exit_time, turn_exit.mA_timeout);
+  odomDrivePID.variables_reset();
+  odomTurnPID.variables_reset();
+  odomDriveExit = ez::RUNNING;
+  odomTurnExit = pose ? ez::RUNNING : ez::SMALL_EXIT;
+  odomSettling = false;
+}
+
+void odomMotionStart(double x, double y, double theta, bool pose, int speed, bool backwards) {
+  odomTargetMutex.take();
+  odomTarget = {x, y, theta, pose, std::abs(speed), backwards};
+  odomPath.reset();
+  odomProfile = {nullptr, nullptr, 0};
+  odomTargetMutex.give();
+
+  odomPIDsReset(pose);
+  chassis.drive_mode_set(ez::DISABLE);  // EZ's task lets go of the drive, the odom motion job takes it
+  odomRunning = true;
+}
+
+void odomPathStart(const Path& path, int speed, bool backwards) {
+  if (path.size() == 0) return;
+
+  odomTargetMutex.take();
+  odomTarget = {path.x.back(), path.y.back(), 0, false, std::abs(speed), backwards};
+  odomPath = std::make_unique<Path>(path);
+  odomProfile = {nullptr, nullptr, 0};
+  odomPathClosest = 0;
+  odomPathIndex = 0;
+  odomPathT = 0;
+  odomTargetMutex.give();
+
+  odomPIDsReset(false);
+  chassis.drive_mode_set(ez::DISABLE);
+  odomRunning = true;
+}
+
+void odomProfileStart(const BakedProfile& profile, bool backwards) {
+  if (profile.size == 0) return;
+
+  Pose start = odomGet();
+  double distance = profile.samples[profile.size - 1].position * (backwards ? -1 : 1);
+  odomTargetMutex.take();
+  odomTarget = {start.x + distance * std::sin(odomRadians(start.theta)), start.y + distance * std::cos(odomRadians(start.theta)), 0, false, 127, backwards};
+  odomPath.reset();
+  odomProfile = profile;
+  odomProfileFrom = start;
+  odomProfileTime = pros::millis();
+  odomTargetMutex.give();
+
+  odomPIDsReset(false);
+  chassis.drive_mode_set(ez::DISABLE);
+  odomRunning = true;
+}
+
+// One baked profile step, with odomTargetMutex held
+static void odomProfileIterate(const OdomTarget& target, Pose pose) {
+  double sign = target.backwards ? -1.0 : 1.0;
+  double heading = odomRadians(odomProfileFrom.theta);
+  double travelled = sign * ((pose.x - odomProfileFrom.x) * std::sin(heading) + (pose.y - odomProfileFrom.y) * std::cos(heading));
+
+  int tick = (pros::millis() - odomProfileTime) / ez::util::DELAY_TIME;
+  const ProfileSample& sample = odomProfile.samples[std::min(tick, odomProfile.size - 1)];
+  double error = sample.position - travelled;
+  double remaining = odomProfile.samples[odomProfile.size - 1].position - travelled;
+
+  double power;
+  if (tick >= odomProfile.size - 1 || odomSettling) {
+    // Off the end of the table, finish like a drive
+    odomSettling = true;
+    power = ez::util::clamp(odomDrivePID.compute_error(remaining, -remaining), (double)target.speed, (double)-target.speed);
+  } else {
+    odomDrivePID.compute_error(remaining, -remaining);  // Keeps the exit conditions current
+    double accel = (odomProfile.samples[tick + 1].velocity - sample.velocity) / PROFILE_DT;
+    power = PROFILE_KV * sample.velocity + PROFILE_KA * accel + PROFILE_KP * error;
+  }
+
+  // Hold the heading it started at
+  double angle = odomWrap(odomProfileFrom.theta - pose.theta);
+  double turn = ez::util::clamp(odomTurnPID.compute_error(angle, -angle), (double)target.speed, (double)-target.speed);
+  power = ez::util::clamp(power, target.speed - std::abs(turn), -(target.speed - std::abs(turn)));
+  chassis.drive_set(sign * power + turn, sign * power - turn);
+}
+
+// One pure pursuit step, with odomTargetMutex held
+static void odomPathIterate(const OdomTarget& target, Pose pose) {
+  const Path& path = *odomPath;
+  double reverse = target.backwards ? 180.0 : 0.0;
+  double facing = odomRadians(pose.theta + reverse);
+
+  odomPathClosest = path.closest(pose.x, pose.y, odomPathClosest);
+  if (odomPathIndex < odomPathClosest) {
+    odomPathIndex = std::min(odomPathClosest, path.size() - 2);
+    odomPathT = 0;
+  }
+  double remaining = path.distance.back() - path.distance[odomPathClosest];
+
+  // Steer at the lookahead point, or the end once it's inside the lookahead
+  double look_x = path.x.back(), look_y = path.y.back();
+  if (remaining < PURSUIT_LOOKAHEAD || odomSettling) {
+    odomSettling = true;
+  } else if (path.size() > 1) {
+    // Off the path the circle can miss it, keep the last lookahead point
+    path.lookahead(pose.x, pose.y, PURSUIT_LOOKAHEAD, odomPathIndex, odomPathT);
+    int i = std::min(odomPathIndex, path.size() - 2);
+    look_x = path.x[i] + (path.x[i + 1] - path.x[i]) * odomPathT;
+    look_y = path.y[i] + (path.y[i + 1] - path.y[i]) * odomPathT;
+  }
+
+  double dx = look_x - pose.x;
+  double dy = look_y - pose.y;
+  double forward = dx * std::sin(facing) + dy * std::cos(facing);
+  double lateral = dx * std::cos(facing) - dy * std::sin(facing);
+  double length = dx * dx + dy * dy;
+  // Arc through the lookahead point, 1 / radius, positive curves right
+  double curvature = length > 4.0 ? 2.0 * lateral / length : 0.0;
+
+  double power;
+  if (odomSettling) {
+    // Derivative on the error, like the other odom motions
+    power = ez::util::clamp(odomDrivePID.compute_error(forward, -forward), (double)target.speed, (double)-target.speed);
+  } else {
+    odomDrivePID.compute_error(remaining, -remaining);  // Keeps the exit conditions current
+    power = std::min((double)target.speed, path.speed[odomPathClosest]);
+  }
+
+  // Curvature is the turn per inch driven, so the split scales with the power and track width
+  double turn = power * curvature * DRIVE_TRACK_WIDTH / 2.0;
+  if (target.backwards) power = -power;
+  double left = power + turn, right = power - turn;
+  double most = std::max(std::abs(left), std::abs(right));
+  if (most > target.speed) {
+    left *= target.speed / most;
+    right *= target.speed / most;
+  }
+  chassis.drive_set(left, right);
+}
+
+void odomMotionIterate() {
+  if (!odomRunning) return;
+  // Starting an EZ motion takes the drive back
+  if (chassis.drive_mode_get() != ez::DISABLE) {
+    odomRunning = false;
+    return;
+  }
+
+  odomTargetMutex.take();
+  if (odomPath) {
+    odomPathIterate(odomTarget, odomGet());
+    odomTargetMutex.give();
+    return;
+  }
+  if (odomProfile.samples) {
+    odomProfileIterate(odomTarget, odomGet());
+    odomTargetMutex.give();
+    return;
+  }
+  OdomTarget target = odomTarget;
+  odomTargetMutex.give();
+
+  Pose pose = odomGet();
+  double dx = target.x - pose.x;
+  double dy = target.y - pose.y;
+  double distance = std::hypot(dx, dy);
+  double reverse = target.backwards ? 180.0 : 0.0;
+  double facing = pose.theta + reverse;
+
+  double linear, angle;
+  if (distance < ODOM_SETTLE_RADIUS || odomSettling) {
+    // Close in, steering hard at the point would spin the robot around it
+    odomSettling = true;
+    linear = dx * std::sin(odomRadians(facing)) + dy * std::cos(odomRadians(facing));
+    if (target.pose) {
+      angle = odomWrap(target.theta - pose.theta);
+    } else {
+      // Still lean toward the point, less the closer it is, backing up to it if that's less turning
+      double bearing = odomWrap(std::atan2(dx, dy) * 180.0 / M_PI - facing);
+      if (bearing > 90) bearing -= 180;
+      if (bearing < -90) bearing += 180;
+      angle = bearing * std::min(1.0, distance / ODOM_SETTLE_RADIUS);
+    }
+  } else {
+    double carrot_x = target.x, carrot_y = target.y;
+    if (target.pose) {
+      carrot_x -= distance * ODOM_LEAD * std::sin(odomRadians(target.theta + reverse));
+      carrot_y -= distance * ODOM_LEAD * std::cos(odomRadians(target.theta + reverse));
+    }
+    angle = odomWrap(std::atan2(carrot_x - pose.x, carrot_y - pose.y) * 180.0 / M_PI - facing);
+    linear = distance * std::cos(odomRadians(angle));
+  }
+
+  // Derivative on the error, the target moves
+  double drive_out = odomDrivePID.compute_error(linear, -linear);
+  double turn_out = odomTurnPID.compute_error(angle, -angle);
+  turn_out = ez::util::clamp(turn_out, target.speed, -target.speed);
+  // Turning gets the power first so the robot stays on its curve at full speed
+  double drive_limit = target.speed - std::abs(turn_out);
+  drive_out = ez::util::clamp(drive_out, drive_limit, -drive_limit);
+  if (target.backwards) drive_out = -drive_out;
+
+  chassis.drive_set(drive_out + turn_out, drive_out - turn_out);
+}
+
+bool odomMotionRunning() {
+  return odomRunning;
+}
+
+ez::exit_output odomMotionExit(bool print) {
+  if (!odomRunning) return ez::SMALL_EXIT;
+
+  odomTargetMutex.take();
+  bool following = odomPath != nullptr || odomProfile.samples != nullptr;
+  odomTargetMutex.give();
+
+  std::vector<pros::Motor> sensors = {chassis.left_motors[0], chassis.right_motors[0]};
+  // Paths and profiles only settle at their end
+  if (odomDriveExit == ez::RUNNING && (odomSettling || !following)) {
+    odomDriveExit = odomDrivePID.exit_condition(sensors, print);
+    // The drive PID only sees the distance along the heading, a point off to the side isn't there yet
+    bool settled = odomDriveExit == ez::SMALL_EXIT || odomDriveExit == ez::BIG_EXIT;
+    if (settled && !following && odomMotionError() > odomDrivePID.exit.big_error) odomDriveExit = ez::RUNNING;
+  }
+  // The heading only counts once it's turning to the final heading
+  if (odomTurnExit == ez::RUNNING && odomSettling) odomTurnExit = odomTurnPID.exit_condition(sensors, print);
+  if (odomDriveExit == ez::RUNNING || odomTurnExit == ez::RUNNING) return ez::RUNNING;
+
+  odomRunning = false;
+  chassis.drive_set(0, 0);
+
+  // Relative turns and drive heading hold carry on from where this ended
+  odomTargetMutex.take();
+  OdomTarget target = odomTarget;
+  odomTargetMutex.give();
+  double imu_offset = odomGet().theta - chassis.drive_imu_get();
+  chassis.headingPID.target_set(target.pose ? target.theta - imu_offset : chassis.drive_imu_get());
+  return std::max(odomDriveExit, odomTurnExit);
+}
+
+double odomMotionError() {
+  odomTargetMutex.take();
+  OdomTarget target = odomTarget;
+  odomTargetMutex.give();
+  Pose pose = odomGet();
+  return std::hypot(target.x - pose.x, target.y - pose.y);
+}
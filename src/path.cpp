@@ -0,0 +1,129 @@
+#include "main.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+// Curvature is measured across this many inches either side of a point
+const double PATH_CURVE_SPAN = 6.0;
+// Power allowed on a 12 inch radius, scales with the radius
+const double PATH_CURVE_SPEED = 60.0;
+// Power the robot can shed per inch of path
+const double PATH_DECEL = 5.0;
+// Points the closest point search walks forward, more than the robot covers in a cycle
+const int PATH_SEARCH_POINTS = 16;
+
+Path::Path(std::vector<Waypoint> waypoints, double spacing) {
+  if (waypoints.empty()) return;
+  if (spacing <= 0) spacing = 1.0;
+
+  for (size_t i = 0; i + 1 < waypoints.size(); i++) {
+    Waypoint a = waypoints[i];
+    Waypoint b = waypoints[i + 1];
+    int steps = std::max(1, (int)std::ceil(std::hypot(b.x - a.x, b.y - a.y) / spacing));
+    for (int step = 0; step < steps; step++) {
+      x.push_back(a.x + (b.x - a.x) * step / steps);
+      y.push_back(a.y + (b.y - a.y) * step / steps);
+    }
+  }
+  x.push_back(waypoints.back().x);
+  y.push_back(waypoints.back().y);
+
+  distancesSet();
+  speedsSet();
+}
+
+Path::Path(std::vector<double> x, std::vector<double> y) : x(std::move(x)), y(std::move(y)) {
+  // Padding or cutting one to fit would make up points, an empty path doesn't drive
+  if (this->x.size() != this->y.size()) {
+    printf("Path has %i x's and %i y's, not following it\n", (int)this->x.size(), (int)this->y.size());
+    this->x.clear();
+    this->y.clear();
+  }
+  distancesSet();
+  speedsSet();
+}
+
+void Path::distancesSet() {
+  distance.assign(x.size(), 0.0);
+  for (int i = 1; i < size(); i++)
+    distance[i] = distance[i - 1] + std::hypot(x[i] - x[i - 1], y[i] - y[i - 1]);
+}
+
+void Path::speedsSet() {
+  speed.assign(size(), 127.0);
+  if (size() == 0) return;
+
+  // Curvature through the points a span behind and ahead, 1 / radius of the circle through all three
+  int span = 1;
+  while (span < size() && distance[span] < PATH_CURVE_SPAN) span++;
+  for (int i = 1; i + 1 < size(); i++) {
+    int a = std::max(0, i - span);
+    int c = std::min(size() - 1, i + span);
+    double ab = std::hypot(x[i] - x[a], y[i] - y[a]);
+    double bc = std::hypot(x[c] - x[i], y[c] - y[i]);
+    double ca = std::hypot(x[a] - x[c], y[a] - y[c]);
+    double cross = (x[i] - x[a]) * (y[c] - y[a]) - (y[i] - y[a]) * (x[c] - x[a]);
+    double curvature = ab * bc * ca > 1e-9 ? 2.0 * std::abs(cross) / (ab * bc * ca) : 0.0;
+    if (curvature > 1e-9) speed[i] = std::min(127.0, PATH_CURVE_SPEED * (1.0 / curvature) / 12.0);
+  }
+
+  // Slow down ahead of bends and the end, stopping on the last point
+  speed.back() = 0;
+  for (int i = size() - 2; i >= 0; i--)
+    speed[i] = std::min(speed[i], speed[i + 1] + PATH_DECEL * (distance[i + 1] - distance[i]));
+}
+
+int Path::size() const {
+  return x.size();
+}
+
+Path Path::mirrored() const {
+  Path path = *this;
+  for (double& point : path.x) point = -point;
+  return path;
+}
+
+int Path::closest(double px, double py, int from) const {
+  from = std::clamp(from, 0, size() - 1);
+  int best = from;
+  double best_distance = std::hypot(x[from] - px, y[from] - py);
+  int last = std::min(size() - 1, from + PATH_SEARCH_POINTS);
+  for (int i = from + 1; i <= last; i++) {
+    double d = std::hypot(x[i] - px, y[i] - py);
+    if (d < best_distance) {
+      best = i;
+      best_distance = d;
+    }
+  }
+  return best;
+}
+
+bool Path::lookahead(double px, double py, double radius, int& index, double& t) const {
+  if (size() < 2) return false;
+
+  // The circle can't reach further along than this many points past the lookahead
+  int last = std::min(size() - 1, index + PATH_SEARCH_POINTS + (int)std::ceil(2.0 * radius / std::max(1e-3, distance[1])));
+  for (int i = std::max(0, index); i < last; i++) {
+    double dx = x[i + 1] - x[i];
+    double dy = y[i + 1] - y[i];
+    double fx = x[i] - px;
+    double fy = y[i] - py;
+    double a = dx * dx + dy * dy;
+    if (a < 1e-9) continue;
+    double b = 2.0 * (fx * dx + fy * dy);
+    double c = fx * fx + fy * fy - radius * radius;
+    double discriminant = b * b - 4.0 * a * c;
+    if (discriminant < 0) continue;
+
+    // The far crossing is the one ahead of the robot
+    double crossing = (-b + std::sqrt(discriminant)) / (2.0 * a);
+    if (crossing < 0 || crossing > 1) continue;
+    if (i == index && crossing < t) continue;
+    index = i;
+    t = crossing;
+    return true;
+  }
+  return false;
+}
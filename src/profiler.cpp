@@ -0,0 +1,107 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "EZ-Template/util.hpp"
+
+Histogram::Histogram(std::string name, int bucket_width) : name(name), bucket_width(bucket_width) {
+  reset();
+}
+
+void Histogram::record(int time) {
+  int bucket = std::clamp(time / bucket_width, 0, BUCKETS - 1);
+  buckets[bucket]++;
+  count++;
+
+  int current = max;
+  while (time > current && !max.compare_exchange_weak(current, time)) {
+  }
+}
+
+int Histogram::percentile(double p) {
+  std::uint32_t total = count;
+  if (total == 0) return 0;
+
+  std::uint32_t target = std::max<std::uint32_t>(1, std::ceil(total * p));
+  std::uint32_t seen = 0;
+  for (int i = 0; i < BUCKETS; i++) {
+    seen += buckets[i];
+    // Report the top of the bucket, the last bucket has no top so use the max
+    if (seen >= target) return i == BUCKETS - 1 ? max.load() : std::min((i + 1) * bucket_width, max.load());
+  }
+  return max;
+}
+
+int Histogram::max_get() { return max; }
+
+int Histogram::count_get() { return count; }
+
+void Histogram::reset() {
+  for (auto& bucket : buckets) bucket = 0;
+  count = 0;
+  max = 0;
+}
+
+std::string Histogram::name_get() { return name; }
+
+// Function statics so histograms can be made from static constructors too
+pros::Mutex& profilerMutex() {
+  static pros::Mutex mutex;
+  return mutex;
+}
+
+std::vector<std::unique_ptr<Histogram>>& profilerHistograms() {
+  static std::vector<std::unique_ptr<Histogram>> histograms;
+  return histograms;
+}
+
+Histogram& profilerGet(std::string name, int bucket_width) {
+  profilerMutex().take();
+  Histogram* found = nullptr;
+  for (auto& histogram : profilerHistograms()) {
+    if (histogram->name_get() == name) found = histogram.get();
+  }
+  if (!found) {
+    profilerHistograms().push_back(std::make_unique<Histogram>(name, bucket_width));
+    found = profilerHistograms().back().get();
+  }
+  profilerMutex().give();
+  return *found;
+}
+
+void profilerWrite(FILE* file) {
+  fprintf(file, "%-16s %8s %8s %8s %8s\n", "name", "count", "p50 us", "p99 us", "max us");
+  profilerMutex().take();
+  for (auto& histogram : profilerHistograms()) {
+    fprintf(file, "%-16s %8i %8i %8i %8i\n", histogram->name_get().c_str(), histogram->count_get(),
+            histogram->percentile(0.5), histogram->percentile(0.99), histogram->max_get());
+  }
+  profilerMutex().give();
+}
+
+void profilerPrint() {
+  profilerWrite(stdout);
+}
+
+void profilerSave() {
+  if (!ez::util::SD_CARD_ACTIVE) {
+    printf("No SD card, not saving profile\n");
+    return;
+  }
+  FILE* file = fopen("/usd/profile.txt", "w");
+  if (!file) return;
+  profilerWrite(file);
+  fclose(file);
+}
+
+void profilerReset() {
+  profilerMutex().take();
+  for (auto& histogram : profilerHistograms()) {
+    histogram->reset();
+  }
+  profilerMutex().give();
+}
@@ -0,0 +1,189 @@
+#include "main.h"
+
+#include <atomic>
+
+// frames the ring buffer holds, 2.5s of driving
+const int RECORDER_BUFFER = 256;
+
+enum recorder_state { RECORDER_IDLE = 0,
+                      RECORDER_OPENING = 1,
+                      RECORDER_RECORDING = 2,
+                      RECORDER_CLOSING = 3 };
+
+std::atomic<recorder_state> recorderState{RECORDER_IDLE};
+RecordFrame recorderBuffer[RECORDER_BUFFER];
+// capture only moves head and flush only moves tail, so neither needs a lock
+std::atomic<int> recorderHead{0};
+std::atomic<int> recorderTail{0};
+std::atomic<int> recorderDropped{0};
+int recorderFrames = 0;
+int recorderSlot = -1;
+FILE* recorderFile = nullptr;
+
+std::vector<RecordFrame> replayFrames;
+std::atomic<int> replayIndex{0};
+
+// voltage in mV to out of 127
+std::int8_t recorderVoltage(double mv){
+    return std::clamp((int)std::round(mv * 127.0 / 12000.0), -127, 127);
+}
+
+std::uint8_t recorderPistons(){
+    return (clamp1.get_value() << 0) | (doinker.get_value() << 1) | (intakePiston.get_value() << 2);
+}
+
+std::string recorderPath(int slot){
+    return "/usd/rec" + std::to_string(slot) + ".bin";
+}
+
+bool recorderExists(int slot){
+    if (!ez::util::SD_CARD_ACTIVE) return false;
+    FILE* file = fopen(recorderPath(slot).c_str(), "rb");
+    if (!file) return false;
+    fclose(file);
+    return true;
+}
+
+bool recorderEnabled(){
+    return recorderState != RECORDER_IDLE;
+}
+
+void recorderToggle(){
+    if (recorderState == RECORDER_IDLE) {
+        if (!ez::util::SD_CARD_ACTIVE) {
+            printf("No SD card, not recording\n");
+            return;
+        }
+        // the file is opened from the recorder job so this never waits on the SD card
+        recorderState = RECORDER_OPENING;
+    } else if (recorderState == RECORDER_RECORDING) {
+        recorderState = RECORDER_CLOSING;
+    }
+}
+
+void recorderCapture(const InputSnapshot& snapshot){
+    if (recorderState != RECORDER_RECORDING) return;
+
+    int head = recorderHead.load(std::memory_order_relaxed);
+    int next = (head + 1) % RECORDER_BUFFER;
+    if (next == recorderTail.load(std::memory_order_acquire)) {
+        recorderDropped++;
+        return;
+    }
+
+    RecordFrame& frame = recorderBuffer[head];
+    frame.held = snapshot.held;
+    for (int axis = 0; axis < 4; axis++) frame.analog[axis] = snapshot.analog[axis];
+    frame.drive[0] = recorderVoltage(chassis.left_motors[0].get_voltage());
+    frame.drive[1] = recorderVoltage(chassis.right_motors[0].get_voltage());
+    frame.intake = recorderVoltage(intake.get_voltage());
+    frame.lift = recorderVoltage(lift.get_voltage());
+    frame.pistons = recorderPistons();
+    frame.reserved = 0;
+    recorderHead.store(next, std::memory_order_release);
+}
+
+void recorderOpen(){
+    recorderSlot = -1;
+    for (int slot = 0; slot < RECORDER_SLOTS; slot++) {
+        if (!recorderExists(slot)) {
+            recorderSlot = slot;
+            break;
+        }
+    }
+    if (recorderSlot == -1) {
+        printf("All %i recording slots are full, not recording\n", RECORDER_SLOTS);
+        recorderState = RECORDER_IDLE;
+        return;
+    }
+
+    recorderFile = fopen(recorderPath(recorderSlot).c_str(), "wb");
+    if (!recorderFile) {
+        recorderState = RECORDER_IDLE;
+        return;
+    }
+
+    RecordHeader header = {{'R', 'E', 'C', '1'}, (std::uint8_t)ez::util::DELAY_TIME, (std::uint8_t)chassis.left_motors[0].get_brake_mode(), recorderPistons(), 0};
+    fwrite(&header, sizeof(header), 1, recorderFile);
+
+    recorderFrames = 0;
+    recorderDropped = 0;
+    recorderTail = recorderHead.load();
+    recorderState = RECORDER_RECORDING;
+    printf("Recording to %s\n", recorderPath(recorderSlot).c_str());
+}
+
+void recorderFlush(){
+    if (recorderState == RECORDER_OPENING) recorderOpen();
+    if (!recorderFile) return;
+
+    // write whatever is buffered in at most two runs, the end of the ring and the start
+    int head = recorderHead.load(std::memory_order_acquire);
+    int tail = recorderTail.load(std::memory_order_relaxed);
+    while (tail != head) {
+        int end = head > tail ? head : RECORDER_BUFFER;
+        fwrite(&recorderBuffer[tail], sizeof(RecordFrame), end - tail, recorderFile);
+        recorderFrames += end - tail;
+        tail = end % RECORDER_BUFFER;
+        recorderTail.store(tail, std::memory_order_release);
+    }
+    fflush(recorderFile);
+
+    if (recorderState == RECORDER_CLOSING) {
+        fclose(recorderFile);
+        recorderFile = nullptr;
+        printf("Saved %s, %i frames (%.2fs), %i dropped\n", recorderPath(recorderSlot).c_str(), recorderFrames, recorderFrames * ez::util::DELAY_TIME / 1000.0, recorderDropped.load());
+        recorderState = RECORDER_IDLE;
+    }
+}
+
+bool replayNext(InputSnapshot& snapshot){
+    int index = replayIndex++;
+    if (index >= (int)replayFrames.size()) return false;
+
+    RecordFrame& frame = replayFrames[index];
+    snapshot.held = frame.held;
+    for (int axis = 0; axis < 4; axis++) snapshot.analog[axis] = frame.analog[axis];
+    return true;
+}
+
+void recorderReplay(int slot){
+    FILE* file = ez::util::SD_CARD_ACTIVE ? fopen(recorderPath(slot).c_str(), "rb") : nullptr;
+    if (!file) {
+        printf("Couldn't open %s\n", recorderPath(slot).c_str());
+        return;
+    }
+
+    RecordHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || std::string(header.magic, 4) != "REC1") {
+        printf("%s isn't a recording\n", recorderPath(slot).c_str());
+        fclose(file);
+        return;
+    }
+
+    // load the whole run before starting so playback never waits on the SD card
+    replayFrames.clear();
+    RecordFrame frame;
+    while (fread(&frame, sizeof(frame), 1, file) == 1) replayFrames.push_back(frame);
+    fclose(file);
+    replayIndex = 0;
+
+    // start from how things were when recording started
+    chassis.drive_mode_set(ez::DISABLE);
+    chassis.drive_brake_set((pros::motor_brake_mode_e_t)header.brake);
+    if (header.pistons & (1 << 0)) unclampMogo();
+    else clampMogo();
+    doinkerSet(header.pistons & (1 << 1));
+    if (header.pistons & (1 << 2)) intakeDown();
+    else intakeUp();
+
+    // driver control jobs play the inputs back, the input job feeds them in one per cycle
+    inputSourceSet(replayNext);
+    executor.mode_set(RUN_OPCONTROL);
+    // a recording longer than the auton stops with it, not in driver control
+    while (inputSourceActive() && autonTimerRemaining() > 0) pros::delay(ez::util::DELAY_TIME);
+    inputSourceSet(nullptr);
+    executor.mode_set(RUN_AUTONOMOUS);
+    chassis.drive_set(0, 0);
+    intake.move(0);
+}
@@ -0,0 +1,179 @@
+#include "main.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+
+const char* SPLINE_CACHE_PATH = "/usd/splines.bin";
+
+// How hard the curve leaves and arrives along each heading, times the distance between poses
+const double SPLINE_TANGENT = 1.0;
+// Samples per inch while measuring along the curve
+const int SPLINE_SAMPLES = 8;
+// Bump when splines come out differently from the same poses, so old files get remade
+const uint64_t SPLINE_VERSION = 1;
+
+struct Spline {
+  std::vector<Pose> poses;
+  double spacing;
+  uint64_t key;
+  std::optional<Path> path;
+};
+
+static std::map<std::string, Spline> splines;
+
+// Quintic Hermite curve from p0 to p1 with velocities v0 and v1 and no acceleration at either end
+static double splineHermite(double p0, double v0, double v1, double p1, double t) {
+  double t3 = t * t * t, t4 = t3 * t, t5 = t4 * t;
+  double h0 = 1 - 10 * t3 + 15 * t4 - 6 * t5;
+  double h1 = t - 6 * t3 + 8 * t4 - 3 * t5;
+  double h4 = -4 * t3 + 7 * t4 - 3 * t5;
+  double h5 = 10 * t3 - 15 * t4 + 6 * t5;
+  return h0 * p0 + h1 * v0 + h4 * v1 + h5 * p1;
+}
+
+Path splinePath(const std::vector<Pose>& poses, double spacing) {
+  if (poses.empty()) return Path(std::vector<Path::Waypoint>{});
+  if (spacing <= 0) spacing = 1.0;
+
+  std::vector<double> x = {poses[0].x}, y = {poses[0].y};
+  double travelled = 0;  // Since the last point
+  for (size_t i = 0; i + 1 < poses.size(); i++) {
+    Pose a = poses[i], b = poses[i + 1];
+    double length = std::hypot(b.x - a.x, b.y - a.y) * SPLINE_TANGENT;
+    double ax = std::sin(a.theta * M_PI / 180.0) * length, ay = std::cos(a.theta * M_PI / 180.0) * length;
+    double bx = std::sin(b.theta * M_PI / 180.0) * length, by = std::cos(b.theta * M_PI / 180.0) * length;
+
+    int samples = std::max(SPLINE_SAMPLES, (int)std::ceil(length * SPLINE_SAMPLES));
+    double last_x = a.x, last_y = a.y;
+    for (int sample = 1; sample <= samples; sample++) {
+      double t = (double)sample / samples;
+      double sx = splineHermite(a.x, ax, bx, b.x, t);
+      double sy = splineHermite(a.y, ay, by, b.y, t);
+      travelled += std::hypot(sx - last_x, sy - last_y);
+      last_x = sx;
+      last_y = sy;
+      if (travelled >= spacing) {
+        x.push_back(sx);
+        y.push_back(sy);
+        travelled = 0;
+      }
+    }
+  }
+
+  // Always end on the last pose, replacing a point that landed right next to it
+  if (x.size() > 1 && travelled < spacing / 2) {
+    x.pop_back();
+    y.pop_back();
+  }
+  x.push_back(poses.back().x);
+  y.push_back(poses.back().y);
+  return Path(std::move(x), std::move(y));
+}
+
+// FNV-1a over everything that changes the points
+static uint64_t splineKey(const std::vector<Pose>& poses, double spacing) {
+  uint64_t key = 14695981039346656037ull;
+  auto add = [&key](double value) {
+    unsigned char bytes[sizeof(double)];
+    memcpy(bytes, &value, sizeof(double));
+    for (unsigned char byte : bytes) key = (key ^ byte) * 1099511628211ull;
+  };
+  add(SPLINE_VERSION);
+  add(SPLINE_TANGENT);
+  add(spacing);
+  for (const Pose& pose : poses) {
+    add(pose.x);
+    add(pose.y);
+    add(pose.theta);
+  }
+  return key;
+}
+
+void splineAdd(const std::string& name, std::vector<Pose> poses, double spacing) {
+  uint64_t key = splineKey(poses, spacing);
+  splines.insert_or_assign(name, Spline{std::move(poses), spacing, key, std::nullopt});
+}
+
+void splinesLoad() {
+  if (ez::util::SD_CARD_ACTIVE) splinesRead(SPLINE_CACHE_PATH);
+
+  int made = 0;
+  for (auto& [name, spline] : splines) {
+    if (spline.path) continue;
+    spline.path = splinePath(spline.poses, spline.spacing);
+    made++;
+  }
+
+  if (made > 0) {
+    printf("Made %i spline%s that weren't on the SD card\n", made, made == 1 ? "" : "s");
+    if (ez::util::SD_CARD_ACTIVE) splinesWrite(SPLINE_CACHE_PATH);
+  }
+}
+
+int splinesRead(const char* name) {
+  FILE* file = fopen(name, "rb");
+  if (!file) return 0;
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  // Everything in the file, by key
+  std::map<uint64_t, Path> cached;
+  char magic[4];
+  uint32_t count;
+  if (fread(magic, 1, 4, file) == 4 && !memcmp(magic, "SPL1", 4) && fread(&count, sizeof(count), 1, file) == 1) {
+    for (uint32_t i = 0; i < count; i++) {
+      uint64_t key;
+      uint32_t points;
+      if (fread(&key, sizeof(key), 1, file) != 1 || fread(&points, sizeof(points), 1, file) != 1) break;
+      // A bad count would ask for gigabytes, it has to fit in what's left of the file
+      if (points > (uint64_t)(size - ftell(file)) / (2 * sizeof(float))) break;
+      std::vector<float> values(points * 2);
+      if (fread(values.data(), sizeof(float), values.size(), file) != values.size()) break;
+      cached.insert_or_assign(key, Path(std::vector<double>(values.begin(), values.begin() + points), std::vector<double>(values.begin() + points, values.end())));
+    }
+  }
+  fclose(file);
+
+  int loaded = 0;
+  for (auto& [spline_name, spline] : splines) {
+    auto found = cached.find(spline.key);
+    if (found == cached.end()) continue;
+    spline.path = found->second;
+    loaded++;
+  }
+  return loaded;
+}
+
+bool splinesWrite(const char* name) {
+  FILE* file = fopen(name, "wb");
+  if (!file) return false;
+
+  uint32_t count = splines.size();
+  fwrite("SPL1", 1, 4, file);
+  fwrite(&count, sizeof(count), 1, file);
+  for (auto& [spline_name, spline] : splines) {
+    if (!spline.path) spline.path = splinePath(spline.poses, spline.spacing);
+    const Path& path = *spline.path;
+    uint32_t points = path.size();
+    std::vector<float> values(path.x.begin(), path.x.end());
+    values.insert(values.end(), path.y.begin(), path.y.end());
+    fwrite(&spline.key, sizeof(spline.key), 1, file);
+    fwrite(&points, sizeof(points), 1, file);
+    fwrite(values.data(), sizeof(float), values.size(), file);
+  }
+  return fclose(file) == 0;
+}
+
+const Path& splineGet(const std::string& name) {
+  static const Path empty(std::vector<Path::Waypoint>{});
+  auto found = splines.find(name);
+  if (found == splines.end() || !found->second.path) {
+    printf("No spline called %s\n", name.c_str());
+    return empty;
+  }
+  return *found->second.path;
+}